@@ -0,0 +1,315 @@
+/*
+ * batch.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "batch.h"
+#include "hikerdice_grasp.h"
+#include "instrumentation.h"
+#include "solution_output.h"
+
+static const char* nome_resolucao[] = {"ok", "erro_leitura", "origem_invalida", "impar"};
+
+typedef struct w{
+	pid_t pid;
+	int fd_job;//escrita: jobs para o worker
+	FILE* resultado;//leitura: uma linha de resultado por job
+	long indice;//job em andamento
+	bool ocupado;
+	bool ativo;
+} worker_lote;
+
+/*Linha vazia ou comentario*/
+static bool linha_ignorada(const char* linha){
+	while (isspace((unsigned char) *linha))
+		linha++;
+	return *linha == '\0' || *linha == '#';
+}
+
+/*Resolve um job e escreve a linha de resultado. Sem prazo na linha do job, vale o -d da linha de comando*/
+static void resolver_job(long indice, const char* job, FILE* saida, double prazo_padrao){
+	char mapa[4096];
+	int populacao;
+	double prazo;
+	char linha_texto[32], coluna_texto[32];
+	int lidos = sscanf(job, "%4095s %31s %31s %d %lf", mapa, linha_texto, coluna_texto, &populacao, &prazo);
+	if (lidos < 4){
+		fprintf(saida, "%ld - - - formato_invalido 0 0.000 0 -\n", indice);
+		fflush(saida);
+		return;
+	}
+	int i = ler_posicao(linha_texto);
+	int j = ler_posicao(coluna_texto);
+	populacao_solucao_inicial = populacao;
+	prazo_segundos = lidos == 5 ? prazo : prazo_padrao;
+
+	double inicio = relogio_monotonico();
+	int resultado = resolver_mapa(mapa, i, j);
+	double decorrido = relogio_monotonico() - inicio;
+
+	bool resolvido = resultado == RESOLUCAO_OK && pontuacao_melhor_solucao > 0;
+	fprintf(saida, "%ld %s %d %d %s %d %.3f %llu ", indice, mapa, i, j, solucao_do_cache ? "cache" : nome_resolucao[resultado],
+			resolvido ? pontuacao_melhor_solucao : 0, decorrido, resultado == RESOLUCAO_OK ? count_branches : 0);
+	if (resolvido)
+		imprimir_movimentos(saida, &grade, grid_index(&grade, origin_i, origin_j), melhor_solucao, total_free_vertexes);
+	else
+		fputc('-', saida);
+	fputc('\n', saida);
+	fflush(saida);
+}
+
+/**Resolve os jobs da entrada em sequencia. Com com_indice, cada linha comeca com o indice do job
+ * (protocolo entre o processo principal e os workers); senao o indice eh a ordem na entrada.
+ */
+void laco_lote(FILE* entrada, FILE* saida, bool com_indice){
+	char* linha = NULL;
+	size_t capacidade = 0;
+	long proximo_indice = 0;
+	double prazo_padrao = prazo_segundos;
+	while (getline(&linha, &capacidade, entrada) != -1){
+		if (linha_ignorada(linha))
+			continue;
+		char* job = linha;
+		long indice = com_indice ? strtol(linha, &job, 10) : proximo_indice++;
+		resolver_job(indice, job, saida, prazo_padrao);
+	}
+	free(linha);
+}
+
+static bool escrever_tudo(int fd, const char* dados, size_t tamanho){
+	while (tamanho > 0){
+		ssize_t escrito = write(fd, dados, tamanho);
+		if (escrito < 0 && errno == EINTR)
+			continue;
+		if (escrito <= 0)
+			return false;
+		dados += escrito;
+		tamanho -= (size_t) escrito;
+	}
+	return true;
+}
+
+/*Fecha as pontas dos workers (que recebem EOF e terminam) e espera cada um*/
+static void encerrar_workers(worker_lote* workers, int qtd){
+	for (int w = 0; w < qtd; w++){
+		close(workers[w].fd_job);
+		fclose(workers[w].resultado);
+		waitpid(workers[w].pid, NULL, 0);
+	}
+}
+
+/*Cria os workers; se algum pipe ou fork falhar, encerra os ja criados e retorna false*/
+static bool criar_workers(worker_lote* workers, int qtd){
+	for (int w = 0; w < qtd; w++){
+		int job[2], resultado[2];
+		if (pipe(job) != 0){
+			encerrar_workers(workers, w);
+			return false;
+		}
+		if (pipe(resultado) != 0){
+			close(job[0]);
+			close(job[1]);
+			encerrar_workers(workers, w);
+			return false;
+		}
+		pid_t pid = fork();
+		if (pid < 0){
+			close(job[0]);
+			close(job[1]);
+			close(resultado[0]);
+			close(resultado[1]);
+			encerrar_workers(workers, w);
+			return false;
+		}
+		if (pid == 0){
+			//o worker fecha as pontas dos outros workers, para que eles recebam EOF quando o principal fechar
+			for (int o = 0; o < w; o++){
+				close(workers[o].fd_job);
+				fclose(workers[o].resultado);
+			}
+			close(job[1]);
+			close(resultado[0]);
+			FILE* entrada = fdopen(job[0], "r");
+			FILE* saida = fdopen(resultado[1], "w");
+			laco_lote(entrada, saida, true);
+			fclose(saida);
+			_exit(EXIT_SUCCESS);
+		}
+		close(job[0]);
+		close(resultado[1]);
+		workers[w] = (worker_lote) {.pid = pid, .fd_job = job[1], .resultado = fdopen(resultado[0], "r"), .ativo = true};
+	}
+	return true;
+}
+
+/**Le mais um bloco da entrada padrao para o buffer. Retorna false no fim da entrada, quando a ultima
+ * linha recebe a quebra que faltar.
+ */
+static bool ler_entrada(char** entrada, size_t* tamanho, size_t* capacidade){
+	if (*capacidade - *tamanho < 65536){
+		*capacidade = *capacidade*2 + 65536;
+		*entrada = (char*) realloc(*entrada, *capacidade);
+	}
+	ssize_t lido = read(STDIN_FILENO, *entrada + *tamanho, *capacidade - *tamanho - 1);
+	if (lido < 0 && errno == EINTR)
+		return true;
+	if (lido <= 0){
+		if (*tamanho > 0 && (*entrada)[*tamanho-1] != '\n')
+			(*entrada)[(*tamanho)++] = '\n';//ultima linha sem quebra
+		return false;
+	}
+	*tamanho += (size_t) lido;
+	return true;
+}
+
+/*Nenhum worker vivo: le o resto da entrada e responde cada job ainda nao despachado com erro_worker*/
+static void recusar_jobs_restantes(char** entrada, size_t* tamanho, size_t* capacidade, bool fim_entrada, long proximo_indice){
+	while (!fim_entrada)
+		fim_entrada = !ler_entrada(entrada, tamanho, capacidade);
+	char* linha = *entrada;
+	char* fim = *entrada + *tamanho;
+	char* fim_linha;
+	while (linha < fim && (fim_linha = memchr(linha, '\n', (size_t) (fim - linha))) != NULL){
+		*fim_linha = '\0';
+		if (!linha_ignorada(linha))
+			printf("%ld - - - erro_worker 0 0.000 0 -\n", proximo_indice++);
+		linha = fim_linha + 1;
+	}
+	*tamanho = 0;
+	fflush(stdout);
+}
+
+/**Distribui os jobs da entrada padrao entre os workers, um job por worker de cada vez,
+ * e repassa cada resultado para a saida padrao assim que ele chega.
+ */
+bool executar_lote(int qtd_processos){
+	if (qtd_processos <= 1){
+		laco_lote(stdin, stdout, false);
+		return true;
+	}
+
+	//um worker que morreu ocioso so aparece na escrita do proximo job: EPIPE, em vez de encerrar o lote
+	signal(SIGPIPE, SIG_IGN);
+	fflush(stdout);
+	worker_lote* workers = (worker_lote*) calloc(qtd_processos, sizeof(worker_lote));
+	if (!criar_workers(workers, qtd_processos)){
+		printf("Impossivel criar os workers do modo lote\n");
+		free(workers);
+		return false;
+	}
+
+	char* entrada = NULL;//linhas lidas da entrada padrao e ainda nao despachadas
+	size_t tamanho_entrada = 0, capacidade_entrada = 0;
+	bool fim_entrada = false;
+	long proximo_indice = 0;
+	int ocupados = 0;
+	char* linha = NULL;
+	size_t capacidade_linha = 0;
+	struct pollfd* fds = (struct pollfd*) malloc(sizeof(struct pollfd)*(qtd_processos+1));
+	int* fd_worker = (int*) malloc(sizeof(int)*(qtd_processos+1));
+	bool ok = true;
+
+	while (true){
+		//despacha as linhas completas para os workers ociosos
+		for (int w = 0; w < qtd_processos; w++){
+			if (!workers[w].ativo || workers[w].ocupado)
+				continue;
+			char* fim_linha = NULL;
+			while ((fim_linha = memchr(entrada, '\n', tamanho_entrada)) != NULL){
+				size_t tamanho_linha = (size_t) (fim_linha - entrada) + 1;
+				*fim_linha = '\0';
+				bool ignorada = linha_ignorada(entrada);
+				*fim_linha = '\n';
+				if (ignorada){
+					memmove(entrada, entrada + tamanho_linha, tamanho_entrada - tamanho_linha);
+					tamanho_entrada -= tamanho_linha;
+					continue;
+				}
+				char prefixo[32];
+				int tamanho_prefixo = snprintf(prefixo, sizeof(prefixo), "%ld ", proximo_indice);
+				if (!escrever_tudo(workers[w].fd_job, prefixo, (size_t) tamanho_prefixo)
+						|| !escrever_tudo(workers[w].fd_job, entrada, tamanho_linha)){
+					workers[w].ativo = false;
+					break;
+				}
+				workers[w].indice = proximo_indice++;
+				workers[w].ocupado = true;
+				ocupados++;
+				memmove(entrada, entrada + tamanho_linha, tamanho_entrada - tamanho_linha);
+				tamanho_entrada -= tamanho_linha;
+				break;
+			}
+		}
+
+		bool tem_ocioso = false;
+		bool tem_ativo = false;
+		for (int w = 0; w < qtd_processos; w++){
+			tem_ativo |= workers[w].ativo;
+			tem_ocioso |= workers[w].ativo && !workers[w].ocupado;
+		}
+		if (ocupados == 0 && (fim_entrada || !tem_ativo)){
+			if (!tem_ativo)
+				recusar_jobs_restantes(&entrada, &tamanho_entrada, &capacidade_entrada, fim_entrada, proximo_indice);
+			break;
+		}
+
+		int qtd_fds = 0;
+		if (!fim_entrada && tem_ocioso){
+			fds[qtd_fds] = (struct pollfd) {.fd = STDIN_FILENO, .events = POLLIN};
+			fd_worker[qtd_fds++] = -1;
+		}
+		for (int w = 0; w < qtd_processos; w++){
+			if (workers[w].ocupado){
+				fds[qtd_fds] = (struct pollfd) {.fd = fileno(workers[w].resultado), .events = POLLIN};
+				fd_worker[qtd_fds++] = w;
+			}
+		}
+		if (poll(fds, qtd_fds, -1) < 0){
+			if (errno == EINTR)
+				continue;
+			ok = false;
+			break;
+		}
+
+		for (int k = 0; k < qtd_fds; k++){
+			if (fds[k].revents == 0)
+				continue;
+			if (fd_worker[k] < 0){
+				fim_entrada = !ler_entrada(&entrada, &tamanho_entrada, &capacidade_entrada);
+				continue;
+			}
+
+			worker_lote* worker = &workers[fd_worker[k]];
+			if (getline(&linha, &capacidade_linha, worker->resultado) > 0){
+				fputs(linha, stdout);
+			}
+			else {
+				//worker encerrado no meio do job (ex.: falta de memoria)
+				printf("%ld - - - erro_worker 0 0.000 0 -\n", worker->indice);
+				worker->ativo = false;
+			}
+			fflush(stdout);
+			worker->ocupado = false;
+			ocupados--;
+		}
+	}
+
+	encerrar_workers(workers, qtd_processos);
+	free(entrada);
+	free(linha);
+	free(fds);
+	free(fd_worker);
+	free(workers);
+	return ok;
+}
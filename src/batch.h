@@ -0,0 +1,23 @@
+/*
+ * batch.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/**Modo lote: le jobs "mapa linha coluna populacao [prazo]" da entrada padrao (linhas vazias e iniciadas
+ * por # sao ignoradas; o prazo em segundos eh opcional, como no -d) e escreve um resultado por job, assim que ele termina:
+ * "indice mapa linha coluna status pontuacao segundos branches movimentos".
+ * indice eh a ordem do job na entrada (a partir de 0); os movimentos saem em run-length ("-" se nao houver).
+ * Com mais de um processo, cada worker eh um fork que resolve um job por vez, reaproveitando os seus buffers.
+ */
+bool executar_lote(int qtd_processos);
+void laco_lote(FILE* entrada, FILE* saida, bool com_indice);
+
+#endif /* BATCH_H_ */
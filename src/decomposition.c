@@ -0,0 +1,600 @@
+/*
+ * decomposition.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "decomposition.h"
+#include "hikerdice_grasp.h"
+#include "local_search.h"
+#include "tiled_constructor.h"
+
+#define PRAZO_BLOCO_PADRAO 1.0//segundos por bloco quando nao ha -d: a busca num bloco sem passeio pode nao terminar
+
+int qtd_blocos_decomposicao;
+int qtd_rodadas_decomposicao;
+
+typedef struct{
+	int r0, r1;//linhas [r0, r1) do mapa
+	bool* corte;//corte[c]: ha um corte de blocos antes da coluna c (0 < c < n)
+	int* resolvido_ate;//resolvido_ate[c0] = c1 se o bloco [c0, c1) desta faixa ja foi resolvido, senao -1
+} faixa;
+
+typedef struct{
+	int faixa;
+	int r0, r1, c0, c1;
+	int livres;
+} bloco_mapa;
+
+//o que o filho devolve pelo pipe, seguido de qtd indices da grade do mapa inteiro
+typedef struct{
+	int pontuacao;
+	int qtd;
+	unsigned long long branches;
+	unsigned long long solucoes;
+} resultado_bloco;
+
+typedef struct{
+	pid_t pid;
+	int fd;
+	int bloco;
+	char* dados;
+	size_t tamanho, capacidade;
+} filho_bloco;
+
+static int livres_no_retangulo(int r0, int r1, int c0, int c1){
+	int livres = 0;
+	for (int i = r0; i < r1; i++){
+		for (int j = c0; j < c1; j++){
+			livres += !grade.black[grid_index(&grade, i, j)];
+		}
+	}
+	return livres;
+}
+
+/*Condicoes necessarias para o retangulo ter passeio: casas livres conexas e cada uma com pelo menos
+ *dois vizinhos livres dentro dele (um retangulo sem casas livres tambem serve)*/
+static bool retangulo_viavel(int r0, int r1, int c0, int c1){
+	int h = r1 - r0, w = c1 - c0;
+	bool* alcancada = (bool*) calloc((size_t) h*w, sizeof(bool));
+	int* pilha = (int*) malloc(sizeof(int)*h*w);
+	int livres = 0, alcancadas = 0, topo = 0;
+	bool viavel = true;
+	for (int k = 0; k < h*w && viavel; k++){
+		int idx = grid_index(&grade, r0 + k / w, c0 + k % w);
+		if (grade.black[idx])
+			continue;
+		livres++;
+		int vizinhos = 0;
+		for (int d = 0; d < 4; d++){
+			int i = k / w + (d == ROLL_UP ? -1 : d == ROLL_DOWN ? 1 : 0);
+			int j = k % w + (d == ROLL_LEFT ? -1 : d == ROLL_RIGHT ? 1 : 0);
+			vizinhos += i >= 0 && i < h && j >= 0 && j < w && !grade.black[idx + grade.deslocamento[d]];
+		}
+		viavel = vizinhos >= 2;
+		if (topo == 0 && alcancadas == 0){
+			alcancada[k] = true;
+			pilha[topo++] = k;
+			alcancadas++;
+		}
+	}
+	while (viavel && topo > 0){
+		int k = pilha[--topo];
+		int idx = grid_index(&grade, r0 + k / w, c0 + k % w);
+		for (int d = 0; d < 4; d++){
+			int i = k / w + (d == ROLL_UP ? -1 : d == ROLL_DOWN ? 1 : 0);
+			int j = k % w + (d == ROLL_LEFT ? -1 : d == ROLL_RIGHT ? 1 : 0);
+			if (i < 0 || i >= h || j < 0 || j >= w || alcancada[i*w + j] || grade.black[idx + grade.deslocamento[d]])
+				continue;
+			alcancada[i*w + j] = true;
+			pilha[topo++] = i*w + j;
+			alcancadas++;
+		}
+	}
+	free(alcancada);
+	free(pilha);
+	return viavel && alcancadas == livres;
+}
+
+/*Cortes em [0, L) a cada 'lado' posicoes pelo menos, onde prefixo[p] (livres antes de p) eh par; o ultimo
+ *pedaco fica com pelo menos lado/2. Entre as posicoes ate 2*lado, prefere a primeira em que o pedaco
+ *[inicio, p) eh viavel: faixas do mapa inteiro (f == NULL) ou blocos da faixa f.
+ *Marca corte[p] e retorna a quantidade de cortes*/
+static int cortar(const int* prefixo, int L, int lado, bool* corte, const faixa* f){
+	int qtd = 0;
+	int inicio = 0;
+	for (int p = 1; p < L; p++){
+		corte[p] = false;
+	}
+	while (true){
+		int escolhido = -1;
+		for (int p = inicio + lado; p < inicio + 2*lado && L - p >= (lado+1)/2; p++){
+			if (prefixo[p] % 2 != 0)
+				continue;
+			if (escolhido < 0)
+				escolhido = p;
+			if (f == NULL ? retangulo_viavel(inicio, p, 0, grade.n) : retangulo_viavel(f->r0, f->r1, inicio, p)){
+				escolhido = p;
+				break;
+			}
+		}
+		if (escolhido < 0){
+			//sem posicao de prefixo par ate 2*lado: segue procurando a primeira
+			for (int p = inicio + 2*lado; p < L && L - p >= (lado+1)/2 && escolhido < 0; p++){
+				if (prefixo[p] % 2 == 0)
+					escolhido = p;
+			}
+		}
+		if (escolhido < 0)
+			return qtd;
+		corte[escolhido] = true;
+		inicio = escolhido;
+		qtd++;
+	}
+}
+
+/*Corta a faixa em blocos e marca todos como nao resolvidos. prefixo tem n+1 posicoes*/
+static void cortar_faixa(faixa* f, int lado, int* prefixo){
+	int n = grade.n;
+	for (int j = 0; j <= n; j++){
+		f->resolvido_ate[j] = -1;
+	}
+	prefixo[0] = 0;
+	for (int j = 0; j < n; j++){
+		prefixo[j+1] = prefixo[j] + livres_no_retangulo(f->r0, f->r1, j, j+1);
+	}
+	cortar(prefixo, n, lado, f->corte, f);
+}
+
+/*Processo filho: resolve o bloco como um mapa proprio e escreve o passeio no pipe*/
+static void resolver_bloco(bloco_mapa* b, int fd){
+	int largura_mapa = grade.largura;
+	int h = b->r1 - b->r0, w = b->c1 - b->c0;
+	bool* livre = (bool*) malloc(sizeof(bool)*h*w);
+	for (int i = 0; i < h; i++){
+		for (int j = 0; j < w; j++){
+			livre[i*w + j] = !grade.black[grid_index(&grade, b->r0 + i, b->c0 + j)];
+		}
+	}
+
+	init_grid(&grade, h, w);
+	int origem = -1;
+	total_free_vertexes = 0;
+	for (int k = 0; k < h*w; k++){
+		if (!livre[k])
+			continue;
+		grade.black[grid_index(&grade, k / w, k % w)] = false;
+		total_free_vertexes++;
+		if (origem < 0)
+			origem = k;
+	}
+	m_ = h;
+	n_ = w;
+	origin_i = origem / w;
+	origin_j = origem % w;
+	imprimir_incumbentes = false;
+	if (prazo_segundos <= 0)
+		prazo_segundos = PRAZO_BLOCO_PADRAO;
+	init_data();
+	solve();
+
+	resultado_bloco r = {pontuacao_melhor_solucao, pontuacao_melhor_solucao > 0 ? total_free_vertexes : 0,
+			count_branches, qtd_solucoes_validas};
+	FILE* saida = fdopen(fd, "w");
+	fwrite(&r, sizeof(r), 1, saida);
+	for (int k = 0; k < r.qtd; k++){
+		int idx = (b->r0 + grid_i(&grade, melhor_solucao[k]) + 1)*largura_mapa + b->c0 + grid_j(&grade, melhor_solucao[k]) + 1;
+		fwrite(&idx, sizeof(int), 1, saida);
+	}
+	fclose(saida);
+	_exit(EXIT_SUCCESS);
+}
+
+/*Le o que o filho escreveu: o passeio do bloco vira um ciclo em sucessor[], com o rotulo 'id' em componente[]*/
+static bool guardar_resultado(filho_bloco* f, int id, int* sucessor, int* componente, int* tamanho){
+	resultado_bloco r;
+	if (f->tamanho < sizeof(r))
+		return false;
+	memcpy(&r, f->dados, sizeof(r));
+	if (r.qtd <= 0 || f->tamanho != sizeof(r) + sizeof(int)*(size_t) r.qtd)
+		return false;
+	count_branches += r.branches;
+	qtd_solucoes_validas += r.solucoes;
+	const int* passeio = (const int*) (f->dados + sizeof(r));
+	for (int k = 0; k < r.qtd; k++){
+		sucessor[passeio[k]] = passeio[(k+1) % r.qtd];
+		componente[passeio[k]] = id;
+	}
+	tamanho[id] = r.qtd;
+	return true;
+}
+
+/*Resolve os blocos pendentes em processos filhos, ate qtd_processos ao mesmo tempo.
+ *falhou[k] indica os blocos sem passeio. Retorna false se nao foi possivel criar os processos*/
+static bool resolver_pendentes(bloco_mapa* blocos, int* pendentes, int qtd_pendentes, int qtd_processos,
+		bool* falhou, int* sucessor, int* componente, int* tamanho){
+	filho_bloco* filhos = (filho_bloco*) calloc(qtd_processos, sizeof(filho_bloco));
+	struct pollfd* fds = (struct pollfd*) malloc(sizeof(struct pollfd)*qtd_processos);
+	int* fd_filho = (int*) malloc(sizeof(int)*qtd_processos);
+	int proximo = 0, ativos = 0;
+	bool ok = true;
+	fflush(stdout);
+
+	while (proximo < qtd_pendentes || ativos > 0){
+		for (int f = 0; f < qtd_processos && proximo < qtd_pendentes && ok; f++){
+			if (filhos[f].pid != 0)
+				continue;
+			int canal[2];
+			if (pipe(canal) != 0){
+				ok = false;
+				break;
+			}
+			int k = pendentes[proximo];
+			pid_t pid = fork();
+			if (pid < 0){
+				close(canal[0]);
+				close(canal[1]);
+				ok = false;
+				break;
+			}
+			if (pid == 0){
+				close(canal[0]);
+				resolver_bloco(&blocos[k], canal[1]);
+			}
+			close(canal[1]);
+			filhos[f].pid = pid;
+			filhos[f].fd = canal[0];
+			filhos[f].bloco = k;
+			filhos[f].tamanho = 0;
+			proximo++;
+			ativos++;
+		}
+		if (ativos == 0)
+			break;
+
+		int qtd_fds = 0;
+		for (int f = 0; f < qtd_processos; f++){
+			if (filhos[f].pid != 0){
+				fds[qtd_fds] = (struct pollfd) {.fd = filhos[f].fd, .events = POLLIN};
+				fd_filho[qtd_fds++] = f;
+			}
+		}
+		if (poll(fds, qtd_fds, -1) < 0){
+			if (errno == EINTR)
+				continue;
+			ok = false;
+			break;
+		}
+		for (int k = 0; k < qtd_fds; k++){
+			if (fds[k].revents == 0)
+				continue;
+			filho_bloco* f = &filhos[fd_filho[k]];
+			if (f->capacidade - f->tamanho < 65536){
+				f->capacidade = f->capacidade*2 + 65536;
+				f->dados = (char*) realloc(f->dados, f->capacidade);
+			}
+			ssize_t lido = read(f->fd, f->dados + f->tamanho, f->capacidade - f->tamanho);
+			if (lido < 0 && errno == EINTR)
+				continue;
+			if (lido > 0){
+				f->tamanho += (size_t) lido;
+				continue;
+			}
+			//fim do pipe: o filho terminou (ou morreu, e o bloco conta como sem passeio)
+			close(f->fd);
+			waitpid(f->pid, NULL, 0);
+			falhou[f->bloco] = !guardar_resultado(f, f->bloco, sucessor, componente, tamanho);
+			f->pid = 0;
+			ativos--;
+		}
+	}
+
+	for (int f = 0; f < qtd_processos; f++){
+		free(filhos[f].dados);
+	}
+	free(filhos);
+	free(fds);
+	free(fd_filho);
+	return ok;
+}
+
+/*Inverte o sentido do ciclo que passa por s*/
+static void inverter_ciclo(int* sucessor, int s){
+	int anterior = s, atual = sucessor[s];
+	while (atual != s){
+		int seguinte = sucessor[atual];
+		sucessor[atual] = anterior;
+		anterior = atual;
+		atual = seguinte;
+	}
+	sucessor[s] = anterior;
+}
+
+static inline bool aresta_no_ciclo(const int* sucessor, int a, int b){
+	return sucessor[a] == b || sucessor[b] == a;
+}
+
+/*Costura os ciclos de u1-u2 e v1-v2 (u1 vizinho de v1, u2 de v2), trocando essas arestas por u1-v1 e u2-v2.
+ *O ciclo menor eh o que tem o sentido invertido (se preciso) e o rotulo trocado*/
+static bool costurar(int* sucessor, int* componente, int* tamanho, int u1, int u2, int v1, int v2){
+	if (grade.black[u1] || grade.black[u2] || grade.black[v1] || grade.black[v2])
+		return false;
+	int a = componente[u1], b = componente[v1];
+	if (a == b || componente[u2] != a || componente[v2] != b
+			|| !aresta_no_ciclo(sucessor, u1, u2) || !aresta_no_ciclo(sucessor, v1, v2))
+		return false;
+
+	int troca;
+	if (sucessor[u1] != u2){
+		troca = u1; u1 = u2; u2 = troca;
+		troca = v1; v1 = v2; v2 = troca;
+	}
+	//precisa de u1 -> u2 num ciclo e v2 -> v1 no outro
+	if (sucessor[v2] != v1){
+		if (tamanho[b] <= tamanho[a])
+			inverter_ciclo(sucessor, v1);
+		else {
+			inverter_ciclo(sucessor, u1);
+			troca = u1; u1 = u2; u2 = troca;
+			troca = v1; v1 = v2; v2 = troca;
+		}
+	}
+	sucessor[u1] = v1;
+	sucessor[v2] = u2;
+
+	//u1 -> v1 ... v2 -> u2 ... u1
+	if (tamanho[b] <= tamanho[a]){
+		for (int x = v1; ; x = sucessor[x]){
+			componente[x] = a;
+			if (x == v2) break;
+		}
+		tamanho[a] += tamanho[b];
+		tamanho[b] = 0;
+	}
+	else {
+		for (int x = u2; ; x = sucessor[x]){
+			componente[x] = b;
+			if (x == u1) break;
+		}
+		tamanho[b] += tamanho[a];
+		tamanho[a] = 0;
+	}
+	return true;
+}
+
+/**Ponto de partida da costura: a busca local leva o passeio costurado a um otimo local (os blocos foram
+ * resolvidos com o dado na orientacao inicial, entao as juncoes costumam ter o que melhorar), e o passeio
+ * do construtor em blocos concorre com ele. O melhor dos dois so substitui melhor_solucao se passar da
+ * pontuacao que ja esta la (a do cache, com -C).
+ */
+static void guardar_melhor_passeio(int* passeio){
+	static contexto c;//buffers da busca local, reaproveitados entre os jobs do modo lote
+	init_contexto(&c, semente, 0);
+	int pontuacao = busca_local(&c, passeio);
+	qtd_melhorias_busca_local += c.qtd_melhorias_busca_local;
+
+	pontuacao_construtor_blocos = construir_passeio_em_blocos(&grade, c.origin, total_free_vertexes, c.melhor_solucao);
+	if (pontuacao_construtor_blocos > pontuacao){
+		memcpy(passeio, c.melhor_solucao, sizeof(int)*total_free_vertexes);
+		pontuacao = pontuacao_construtor_blocos;
+	}
+	if (pontuacao > pontuacao_melhor_solucao){
+		memcpy(melhor_solucao, passeio, sizeof(int)*total_free_vertexes);
+		pontuacao_melhor_solucao = pontuacao;
+	}
+}
+
+/*Pontuacao do ciclo percorrido a partir da origem, pelo sucessor*/
+static int pontuar_ciclo(const int* sucessor, int origem){
+	dice d = DICE_INICIAL;
+	int pontuacao = 0;
+	int anterior = origem;
+	int atual = sucessor[origem];
+	while (true){
+		pontuacao += roll(&d, d, grid_direcao(&grade, atual, anterior));
+		if (atual == origem)
+			return pontuacao;
+		anterior = atual;
+		atual = sucessor[atual];
+	}
+}
+
+bool resolver_por_blocos(int lado, int qtd_processos){
+	int m = grade.m, n = grade.n;
+	qtd_blocos_decomposicao = 0;
+	qtd_rodadas_decomposicao = 0;
+	if (lado < 4)
+		lado = 4;
+
+	//faixas de linhas
+	int* prefixo = (int*) malloc(sizeof(int)*((m > n ? m : n) + 1));
+	bool* corte_linha = (bool*) malloc(sizeof(bool)*(m+1));
+	prefixo[0] = 0;
+	for (int i = 0; i < m; i++){
+		prefixo[i+1] = prefixo[i] + livres_no_retangulo(i, i+1, 0, n);
+	}
+	int qtd_faixas = cortar(prefixo, m, lado, corte_linha, NULL) + 1;
+	faixa* faixas = (faixa*) calloc(qtd_faixas, sizeof(faixa));
+	for (int f = 0, r0 = 0; f < qtd_faixas; f++){
+		int r1 = r0 + 1;
+		while (r1 < m && !corte_linha[r1]) r1++;
+		faixas[f].r0 = r0;
+		faixas[f].r1 = r1;
+		r0 = r1;
+
+		//blocos da faixa
+		faixas[f].corte = (bool*) calloc(n+1, sizeof(bool));
+		faixas[f].resolvido_ate = (int*) malloc(sizeof(int)*(n+1));
+		cortar_faixa(&faixas[f], lado, prefixo);
+	}
+
+	int* sucessor = (int*) malloc(sizeof(int)*grade.tamanho);
+	int* componente = (int*) malloc(sizeof(int)*grade.tamanho);
+	int* tamanho = NULL;
+	bloco_mapa* blocos = NULL;
+	int* pendentes = NULL;
+	bool* falhou = NULL;
+	bool ok = true;
+
+	//rodadas: resolve os blocos novos; um bloco sem passeio perde um dos seus cortes e eh resolvido de novo, maior.
+	//Uma faixa inteira sem passeio eh juntada com a faixa de baixo (ou de cima) e cortada de novo
+	while (ok){
+		int qtd_blocos = 0;
+		for (int f = 0; f < qtd_faixas; f++){
+			for (int j = 1; j <= n; j++){
+				qtd_blocos += j == n || faixas[f].corte[j];
+			}
+		}
+		blocos = (bloco_mapa*) realloc(blocos, sizeof(bloco_mapa)*qtd_blocos);
+		pendentes = (int*) realloc(pendentes, sizeof(int)*qtd_blocos);
+		falhou = (bool*) realloc(falhou, sizeof(bool)*qtd_blocos);
+		tamanho = (int*) realloc(tamanho, sizeof(int)*qtd_blocos);
+		int qtd_pendentes = 0;
+		int k = 0;
+		for (int f = 0; f < qtd_faixas; f++){
+			for (int c0 = 0, c1 = 1; c1 <= n; c1++){
+				if (c1 < n && !faixas[f].corte[c1])
+					continue;
+				bloco_mapa* b = &blocos[k];
+				*b = (bloco_mapa) {f, faixas[f].r0, faixas[f].r1, c0, c1, 0};
+				b->livres = livres_no_retangulo(b->r0, b->r1, c0, c1);
+				falhou[k] = false;
+				if (b->livres > 0 && faixas[f].resolvido_ate[c0] != c1)
+					pendentes[qtd_pendentes++] = k;
+				k++;
+				c0 = c1;
+			}
+		}
+		if (qtd_pendentes == 0)
+			break;
+
+		//os rotulos dos blocos mudam de uma rodada para outra; os ciclos ja resolvidos sao rotulados de novo
+		for (k = 0; k < qtd_blocos; k++){
+			tamanho[k] = 0;
+			bloco_mapa* b = &blocos[k];
+			if (b->livres == 0 || faixas[b->faixa].resolvido_ate[b->c0] != b->c1)
+				continue;
+			for (int i = b->r0; i < b->r1; i++){
+				for (int j = b->c0; j < b->c1; j++){
+					int idx = grid_index(&grade, i, j);
+					if (!grade.black[idx])
+						componente[idx] = k;
+				}
+			}
+			tamanho[k] = b->livres;
+		}
+
+		qtd_rodadas_decomposicao++;
+		if (!resolver_pendentes(blocos, pendentes, qtd_pendentes, qtd_processos, falhou, sucessor, componente, tamanho)){
+			ok = false;
+			break;
+		}
+		int faixa_sem_passeio = -1;
+		for (int p = 0; p < qtd_pendentes; p++){
+			bloco_mapa* b = &blocos[pendentes[p]];
+			faixa* f = &faixas[b->faixa];
+			if (!falhou[pendentes[p]]){
+				f->resolvido_ate[b->c0] = b->c1;
+				continue;
+			}
+			//junta com o bloco da direita (ou da esquerda, no fim da faixa)
+			if (b->c1 < n)
+				f->corte[b->c1] = false;
+			else if (b->c0 > 0)
+				f->corte[b->c0] = false;
+			else if (faixa_sem_passeio < 0)
+				faixa_sem_passeio = b->faixa;
+		}
+		if (faixa_sem_passeio >= 0){
+			if (qtd_faixas == 1){
+				ok = false;
+				break;
+			}
+			int f = faixa_sem_passeio < qtd_faixas-1 ? faixa_sem_passeio : faixa_sem_passeio-1;
+			faixas[f].r1 = faixas[f+1].r1;
+			free(faixas[f+1].corte);
+			free(faixas[f+1].resolvido_ate);
+			memmove(&faixas[f+1], &faixas[f+2], sizeof(faixa)*(qtd_faixas-f-2));
+			qtd_faixas--;
+			cortar_faixa(&faixas[f], lado, prefixo);
+		}
+		qtd_blocos_decomposicao = qtd_blocos;
+	}
+
+	//costura: passa pelas fronteiras entre blocos ate nao haver mais o que juntar
+	int qtd_componentes = 0;
+	for (int k = 0; ok && k < qtd_blocos_decomposicao; k++){
+		qtd_componentes += blocos[k].livres > 0;
+	}
+	bool juntou = true;
+	while (ok && qtd_componentes > 1 && juntou){
+		juntou = false;
+		for (int f = 0; f < qtd_faixas; f++){
+			for (int c = 1; c < n; c++){
+				if (!faixas[f].corte[c])
+					continue;
+				for (int i = faixas[f].r0; i+1 < faixas[f].r1; i++){
+					if (costurar(sucessor, componente, tamanho, grid_index(&grade, i, c-1), grid_index(&grade, i+1, c-1),
+							grid_index(&grade, i, c), grid_index(&grade, i+1, c))){
+						qtd_componentes--;
+						juntou = true;
+					}
+				}
+			}
+			if (f == 0)
+				continue;
+			int i = faixas[f].r0;
+			for (int j = 0; j+1 < n; j++){
+				if (costurar(sucessor, componente, tamanho, grid_index(&grade, i-1, j), grid_index(&grade, i-1, j+1),
+						grid_index(&grade, i, j), grid_index(&grade, i, j+1))){
+					qtd_componentes--;
+					juntou = true;
+				}
+			}
+		}
+	}
+	ok = ok && qtd_componentes == 1;
+
+	if (ok){
+		//o ciclo unico eh percorrido a partir da origem, no sentido de maior pontuacao
+		int origem = grid_index(&grade, origin_i, origin_j);
+		int pontuacao = pontuar_ciclo(sucessor, origem);
+		inverter_ciclo(sucessor, origem);
+		int pontuacao_inversa = pontuar_ciclo(sucessor, origem);
+		if (pontuacao_inversa < pontuacao)
+			inverter_ciclo(sucessor, origem);
+		else
+			pontuacao = pontuacao_inversa;
+		int* passeio = (int*) malloc(sizeof(int)*total_free_vertexes);
+		int x = origem;
+		for (int k = 0; k < total_free_vertexes; k++){
+			x = sucessor[x];
+			passeio[k] = x;
+		}
+		guardar_melhor_passeio(passeio);
+		free(passeio);
+	}
+
+	for (int f = 0; f < qtd_faixas; f++){
+		free(faixas[f].corte);
+		free(faixas[f].resolvido_ate);
+	}
+	free(faixas);
+	free(prefixo);
+	free(corte_linha);
+	free(sucessor);
+	free(componente);
+	free(tamanho);
+	free(blocos);
+	free(pendentes);
+	free(falhou);
+	return ok;
+}
@@ -0,0 +1,32 @@
+/*
+ * decomposition.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef DECOMPOSITION_H_
+#define DECOMPOSITION_H_
+
+#include <stdbool.h>
+
+/**Modo de decomposicao (-B lado): o mapa eh cortado em faixas e cada faixa em blocos de cerca de
+ * lado x lado celulas, com cortes onde a quantidade de casas livres antes do corte eh par, de preferencia
+ * deixando pedacos conexos e sem casas com menos de dois vizinhos livres.
+ * Cada bloco eh resolvido como um mapa proprio (solve(), com a origem na primeira casa livre e o dado
+ * na orientacao inicial) num processo filho, ate qtd_processos ao mesmo tempo. Um bloco sem passeio eh
+ * juntado ao vizinho da faixa e resolvido de novo; uma faixa inteira sem passeio eh juntada a faixa vizinha.
+ * Os ciclos dos blocos sao costurados por pares de arestas paralelas na fronteira entre eles
+ * (u1-u2 de um lado e v1-v2 do outro viram u1-v1 e u2-v2) ate sobrar um ciclo so, que eh percorrido
+ * a partir da origem do mapa, no sentido de maior pontuacao, e repontuado com o dado real.
+ * O passeio costurado passa pela busca local e concorre com o do construtor em blocos; o melhor deles so
+ * vai para melhor_solucao se superar a pontuacao que ja esta la (a do cache, com -C).
+ * Retorna true se a costura fechou um passeio, ou false se a decomposicao nao fechar um passeio
+ * (o mapa inteiro como uma faixa so sem passeio, ou ciclos que nao puderam ser costurados).
+ */
+bool resolver_por_blocos(int lado, int qtd_processos);
+
+extern int qtd_blocos_decomposicao;//blocos resolvidos na ultima decomposicao
+extern int qtd_rodadas_decomposicao;//rodadas de resolucao (blocos juntados por falta de passeio geram novas rodadas)
+
+#endif /* DECOMPOSITION_H_ */
@@ -5,83 +5,53 @@
  *      Author: Arthur
  */
 
-#include <stdlib.h>
 #include "dice.h"
 
-/* Creates a new dice with default configuration */
-dice* new_dice(int diceIPos, int diceJPos){
-	dice* n_dice = malloc(sizeof(dice));
-	(*n_dice).bottom = 2;
-	(*n_dice).front = 1;
-	(*n_dice).right = 3;
-	(*n_dice).i = diceIPos;
-	(*n_dice).j = diceJPos;
-	return n_dice;
-}
-
-/* Copy the values from d1 to d2*/
-void copy_values(dice* d1, dice* d2){
-	(*d2).bottom = (*d1).bottom;
-	(*d2).front = (*d1).front;
-	(*d2).right = (*d1).right;
-}
-
-/* The roll operations involves copy value from father dice to the son dice,
- * then, "roll" the die in place, updating its face values;
+/* The roll operations move the die one cell, updating its face values:
+ *   left:  bottom = 7 - right, right = bottom
+ *   up:    bottom = front,     front = 7 - bottom
+ *   right: bottom = right,     right = 7 - bottom
+ *   down:  bottom = 7 - front, front = bottom
+ * Every one of the 24 orientations is reachable from the initial one (2,1,3), so the
+ * operations are precomputed here as a transition table indexed by [state][direction].
  */
 
-int roll_up(dice* d, dice* pai){
-	copy_values(pai, d);
-
-	int old_top_side_value = 7 - (*d).bottom;
-	(*d).bottom = (*d).front;
-	(*d).front = old_top_side_value;
-	return (*d).bottom;
-}
-
-int roll_right(dice* d, dice* pai){
-	copy_values(pai, d);
-
-	int old_top_side_value = 7 - (*d).bottom;
-	(*d).bottom = (*d).right;
-	(*d).right = old_top_side_value;
-	return (*d).bottom;
-}
-
-int roll_down(dice* d, dice* pai){
-	copy_values(pai, d);
-
-	int old_down_side_value = 7 - (*d).front;
-	(*d).front = (*d).bottom;
-	(*d).bottom  = old_down_side_value;
-	return (*d).bottom;
-}
-
-int roll_left(dice* d, dice* pai) {
-	copy_values(pai, d);
-
-	int old_left_side_value = 7 - (*d).right;
-	(*d).right = (*d).bottom;
-	(*d).bottom = old_left_side_value;
-	return (*d).bottom;
-}
-
-int fake_roll_left(dice* d, dice* pai) {
-	int old_left_side_value = 7 - (*d).right;
-	return old_left_side_value;
-}
-
-int fake_roll_down(dice* d, dice* pai){
-	int old_down_side_value = 7 - (*d).front;
-	return old_down_side_value;
-}
-
-int fake_roll_right(dice* d, dice* pai){
-	int old_top_side_value = 7 - (*d).bottom;
-	return old_top_side_value;
-}
-
-int fake_roll_up(dice* d, dice* pai){
-	int old_top_side_value = 7 - (*d).bottom;
-	return old_top_side_value;
-}
+/* Next state for each state and direction (left, up, right, down); comments show bottom,front,right */
+const dice dice_roll[24][4] = {
+	{ 9,  7, 13, 16},// 0: 1,2,4
+	{17, 11,  5, 12},// 1: 1,3,2
+	{ 6, 15, 18,  8},// 2: 1,4,5
+	{14, 19, 10,  4},// 3: 1,5,3
+	{12,  3,  8, 20},// 4: 2,1,3
+	{ 1, 10, 21, 13},// 5: 2,3,6
+	{22, 14,  2,  9},// 6: 2,4,1
+	{11, 23, 15,  0},// 7: 2,6,4
+	{ 4,  2, 16, 21},// 8: 3,1,5
+	{20,  6,  0, 17},// 9: 3,2,1
+	{ 3, 18, 23,  5},//10: 3,5,6
+	{19, 22,  7,  1},//11: 3,6,2
+	{16,  1,  4, 22},//12: 4,1,2
+	{ 0,  5, 20, 18},//13: 4,2,6
+	{23, 17,  3,  6},//14: 4,5,1
+	{ 7, 21, 19,  2},//15: 4,6,5
+	{ 8,  0, 12, 23},//16: 5,1,4
+	{21,  9,  1, 14},//17: 5,3,1
+	{ 2, 13, 22, 10},//18: 5,4,6
+	{15, 20, 11,  3},//19: 5,6,3
+	{13,  4,  9, 19},//20: 6,2,3
+	{ 5,  8, 17, 15},//21: 6,3,5
+	{18, 12,  6, 11},//22: 6,4,2
+	{10, 16, 14,  7},//23: 6,5,4
+};
+
+const uint8_t dice_bottom[24] = {
+	1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6
+};
+
+const uint8_t dice_front[24] = {
+	2, 3, 4, 5, 1, 3, 4, 6, 1, 2, 5, 6, 1, 2, 5, 6, 1, 3, 4, 6, 2, 3, 4, 5
+};
+
+const uint8_t dice_right[24] = {
+	4, 2, 5, 3, 3, 6, 1, 4, 5, 1, 6, 2, 2, 6, 1, 5, 4, 1, 6, 3, 3, 5, 2, 4
+};
@@ -8,21 +8,38 @@
 #ifndef DICE_H_
 #define DICE_H_
 
+#include <stdint.h>
+
+/**Orientacao do dado codificada como um dos 24 estados validos.
+ * O estado eh (bottom-1)*4 + k, onde k eh a posicao do front entre as 4 faces laterais possiveis
+ * (em ordem crescente), e a face da direita fica determinada pela quiralidade do dado.
+ * Rolar e pontuar sao consultas as tabelas abaixo, sem efeitos colaterais.
+ */
+typedef uint8_t dice;
+
 //Configurao inicial: 2,1,3
-typedef struct d{
-	int bottom, front, right;
-	int i, j;
-} dice;
-
-dice* new_dice(int diceIPos, int diceJPos);
-void copy_values(dice* d1, dice* d2);
-int roll_up(dice* d, dice* pai);
-int roll_right(dice* d, dice* pai);
-int roll_down(dice* d, dice* pai);
-int roll_left(dice* d, dice* pai);
-int fake_roll_up(dice* d, dice* pai);
-int fake_roll_right(dice* d, dice* pai);
-int fake_roll_down(dice* d, dice* pai);
-int fake_roll_left(dice* d, dice* pai);
+#define DICE_INICIAL 4
+
+//direcoes de rolagem, na mesma ordem de relacaoPaiFilho (que retorna direcao+1)
+#define ROLL_LEFT 0
+#define ROLL_UP 1
+#define ROLL_RIGHT 2
+#define ROLL_DOWN 3
+
+extern const dice dice_roll[24][4];
+extern const uint8_t dice_bottom[24];
+extern const uint8_t dice_front[24];
+extern const uint8_t dice_right[24];
+
+/*Rola o dado 'pai' na direcao dada, guardando o resultado em d. Retorna a face de baixo*/
+static inline int roll(dice* d, dice pai, int direcao){
+	*d = dice_roll[pai][direcao];
+	return dice_bottom[*d];
+}
+
+/*Face de baixo que o dado 'pai' teria se fosse rolado na direcao dada*/
+static inline int fake_roll(dice pai, int direcao){
+	return dice_bottom[dice_roll[pai][direcao]];
+}
 
 #endif /* DICE_H_ */
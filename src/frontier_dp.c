@@ -0,0 +1,444 @@
+/*
+ * frontier_dp.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "frontier_dp.h"
+
+#define MAX_PLUGS (LADO_MAX_FRONTEIRA+1)
+#define BITS_PLUG 8//rotulo (3 bits) e dado (5 bits)
+#define ESTADO_FECHADO (1ULL << 63)//passeio completo: nenhuma aresta cruza mais a fronteira
+
+#define ROTULO_VAZIO 0
+#define ROTULO_SAIDA 1//fragmento que comeca na origem, com o dado inicial
+#define ROTULO_VOLTA 2//fragmento que termina na origem
+#define PRIMEIRO_ROTULO 3//fragmentos comuns, renumerados pela ordem de aparicao na fronteira
+#define ROTULO_NOVO 7//fragmento criado na celula atual, antes da renumeracao
+
+//decisao de cada estado: arestas que a celula criou
+#define ARESTA_LONGA 1//para a proxima celula ao longo do lado maior
+#define ARESTA_CURTA 2//para a proxima celula da linha
+
+int estados_fronteira;
+
+/**Estados guardados numa linha (ao longo do lado maior) de um mapa sem casas pretas, pela quantidade de
+ * linhas sem casas pretas seguidas ate ela, medidos para cada lado menor. Depois da ultima medida a
+ * quantidade fica estavel (lados 2 a 4) ou ja passou do limite (lados 5 e 6).
+ */
+#define MEDIDAS_POR_LADO 13
+static const int estados_por_linha[LADO_MAX_FRONTEIRA+1][MEDIDAS_POR_LADO] = {
+	{0},
+	{1},
+	{96, 145},
+	{192, 1441, 1489, 2881, 2977, 5761, 5905, 10081, 10273, 15841, 15889, 17281},
+	{2592, 14353, 33602, 81626, 171674, 324146, 546530, 787970, 1001666, 1149122, 1222850, 1241282},
+	{7296, 125185, 286922, 1085714, 2355842, 5944778, 9733802, 16990850, 21852290, 29081666, 31081538,
+			33514562, 33747842},
+	{69600, 1042513, 4931043, 24733011, 92710755},
+};
+
+/**Fronteira decodificada. Os plugs 0..lado-1 sao as arestas longas (da celula (a-1, b) para (a, b)) e o
+ * plug 'lado' eh a aresta curta (de (a, b-1) para (a, b)), onde a anda pelo lado maior e b pelo menor.
+ * Rolar de volta desfaz a rolagem, entao a orientacao de cada celula nao depende do sentido em que o passeio
+ * a atravessa: os fragmentos comuns nao guardam sentido, so a saida e a volta da origem se distinguem.
+ */
+typedef struct{
+	int rotulo[MAX_PLUGS];//fragmento do passeio que usa a aresta (ROTULO_VAZIO = aresta fora do passeio)
+	int dado[MAX_PLUGS];//orientacao que o dado deve ter na celula do outro lado
+	bool fechado;
+} fronteira;
+
+/**Estados de uma camada (a fronteira depois de processar uma celula), com a melhor pontuacao de cada um.
+ * anterior e decisao ficam guardados de todas as camadas para reconstruir o passeio no fim.
+ */
+typedef struct{
+	uint64_t* chave;
+	int* pontuacao;
+	uint32_t* anterior;//estado da camada anterior que levou a este
+	uint8_t* decisao;//arestas criadas pela celula
+	int qtd;
+	int capacidade;
+	int* tabela;//indice+1 do estado de cada chave (enderecamento aberto), 0 = vazio
+	int mascara;
+} camada;
+
+/**O que a expansao de um estado precisa saber da celula atual*/
+typedef struct{
+	camada* prox;
+	int plugs;
+	int b;
+	int dir_longa, dir_curta;
+	bool pode_longa, pode_curta;//a celula seguinte na direcao existe e eh livre
+	bool origem;
+	uint32_t anterior;
+	int pontuacao;
+} passo;
+
+static uint64_t codificar(const fronteira* f, int plugs){
+	if (f->fechado)
+		return ESTADO_FECHADO;
+	int novo[8] = {ROTULO_VAZIO, ROTULO_SAIDA, ROTULO_VOLTA};
+	int proximo = PRIMEIRO_ROTULO;
+	uint64_t chave = 0;
+	for (int k = 0; k < plugs; k++){
+		int r = f->rotulo[k];
+		if (r == ROTULO_VAZIO)
+			continue;
+		if (novo[r] == 0)
+			novo[r] = proximo++;
+		chave |= (uint64_t) (novo[r] | f->dado[k] << 3) << (BITS_PLUG*k);
+	}
+	return chave;
+}
+
+static void decodificar(uint64_t chave, fronteira* f, int plugs){
+	f->fechado = chave == ESTADO_FECHADO;
+	for (int k = 0; k < plugs; k++){
+		int plug = (int) (chave >> (BITS_PLUG*k)) & ((1 << BITS_PLUG) - 1);
+		f->rotulo[k] = plug & 7;
+		f->dado[k] = plug >> 3;
+	}
+}
+
+static void camada_reindexar(camada* c, int tamanho){
+	free(c->tabela);
+	c->tabela = (int*) calloc(tamanho, sizeof(int));
+	c->mascara = tamanho - 1;
+	for (int i = 0; i < c->qtd; i++){
+		int pos = (int) ((c->chave[i] * 0x9E3779B97F4A7C15ULL) >> 33) & c->mascara;
+		while (c->tabela[pos] != 0)
+			pos = (pos + 1) & c->mascara;
+		c->tabela[pos] = i + 1;
+	}
+}
+
+/*Insere o estado ou, se a chave ja existe, fica com a maior pontuacao*/
+static void camada_inserir(camada* c, uint64_t chave, int pontuacao, uint32_t anterior, uint8_t decisao){
+	if (2*(c->qtd + 1) > c->mascara + 1)
+		camada_reindexar(c, c->tabela == NULL ? 64 : 2*(c->mascara + 1));
+	int pos = (int) ((chave * 0x9E3779B97F4A7C15ULL) >> 33) & c->mascara;
+	while (c->tabela[pos] != 0){
+		int i = c->tabela[pos] - 1;
+		if (c->chave[i] == chave){
+			if (pontuacao > c->pontuacao[i]){
+				c->pontuacao[i] = pontuacao;
+				c->anterior[i] = anterior;
+				c->decisao[i] = decisao;
+			}
+			return;
+		}
+		pos = (pos + 1) & c->mascara;
+	}
+	if (c->qtd == c->capacidade){
+		c->capacidade = c->capacidade == 0 ? 64 : 2*c->capacidade;
+		c->chave = (uint64_t*) realloc(c->chave, sizeof(uint64_t)*c->capacidade);
+		c->pontuacao = (int*) realloc(c->pontuacao, sizeof(int)*c->capacidade);
+		c->anterior = (uint32_t*) realloc(c->anterior, sizeof(uint32_t)*c->capacidade);
+		c->decisao = (uint8_t*) realloc(c->decisao, sizeof(uint8_t)*c->capacidade);
+	}
+	c->chave[c->qtd] = chave;
+	c->pontuacao[c->qtd] = pontuacao;
+	c->anterior[c->qtd] = anterior;
+	c->decisao[c->qtd] = decisao;
+	c->tabela[pos] = ++c->qtd;
+}
+
+static void emitir(passo* p, const fronteira* f, int pontos, uint8_t decisao){
+	camada_inserir(p->prox, codificar(f, p->plugs), p->pontuacao + pontos, p->anterior, decisao);
+}
+
+static void renomear(fronteira* f, int plugs, int de, int para){
+	for (int k = 0; k < plugs; k++){
+		if (f->rotulo[k] == de)
+			f->rotulo[k] = para;
+	}
+}
+
+static bool fronteira_vazia(const fronteira* f, int plugs){
+	for (int k = 0; k < plugs; k++){
+		if (f->rotulo[k] != ROTULO_VAZIO)
+			return false;
+	}
+	return true;
+}
+
+/*Poe o fragmento 'rotulo' na aresta que sai da celula atual na direcao longa ou curta*/
+static void ligar(passo* p, fronteira* f, bool longa, int rotulo, int dado_celula){
+	int k = longa ? p->b : p->plugs - 1;
+	f->rotulo[k] = rotulo;
+	f->dado[k] = dice_roll[dado_celula][longa ? p->dir_longa : p->dir_curta];
+}
+
+/*Celula livre comum: a pontuacao dela eh a face de baixo da orientacao que as arestas impoem (ou de uma nova)*/
+static void expandir_celula(passo* p, fronteira f){
+	int u = p->b, l = p->plugs - 1;
+	bool tem_u = f.rotulo[u] != ROTULO_VAZIO, tem_l = f.rotulo[l] != ROTULO_VAZIO;
+	if (tem_u && tem_l){
+		//dois fragmentos se juntam na celula: as duas arestas precisam concordar no dado
+		if (f.dado[u] != f.dado[l])
+			return;
+		int a = f.rotulo[u], b = f.rotulo[l], o = f.dado[u];
+		f.rotulo[u] = f.rotulo[l] = ROTULO_VAZIO;
+		if (a == b)
+			return;//ciclo sem a origem
+		if (a + b == ROTULO_SAIDA + ROTULO_VOLTA){
+			if (!fronteira_vazia(&f, p->plugs))
+				return;
+			f.fechado = true;
+		}
+		else if (b == ROTULO_SAIDA || b == ROTULO_VOLTA)
+			renomear(&f, p->plugs, a, b);
+		else
+			renomear(&f, p->plugs, b, a);
+		emitir(p, &f, dice_bottom[o], 0);
+	}
+	else if (tem_u || tem_l){
+		//o fragmento continua para a celula seguinte longa ou curta
+		int k = tem_u ? u : l;
+		int rotulo = f.rotulo[k], o = f.dado[k];
+		f.rotulo[k] = ROTULO_VAZIO;
+		for (int longa = 0; longa < 2; longa++){
+			if (!(longa ? p->pode_longa : p->pode_curta))
+				continue;
+			fronteira g = f;
+			ligar(p, &g, longa, rotulo, o);
+			emitir(p, &g, dice_bottom[o], longa ? ARESTA_LONGA : ARESTA_CURTA);
+		}
+	}
+	else if (p->pode_longa && p->pode_curta){
+		//comeca um fragmento novo, com a orientacao do dado em aberto
+		for (int o = 0; o < 24; o++){
+			fronteira g = f;
+			ligar(p, &g, true, ROTULO_NOVO, o);
+			ligar(p, &g, false, ROTULO_NOVO, o);
+			emitir(p, &g, dice_bottom[o], ARESTA_LONGA | ARESTA_CURTA);
+		}
+	}
+}
+
+/*Origem: uma aresta leva o dado inicial para fora (ROTULO_SAIDA) e a outra traz o dado de volta (ROTULO_VOLTA),
+ *pontuando a face de baixo com que ele chega*/
+static void expandir_origem(passo* p, fronteira f){
+	int u = p->b, l = p->plugs - 1;
+	bool tem_u = f.rotulo[u] != ROTULO_VAZIO, tem_l = f.rotulo[l] != ROTULO_VAZIO;
+	if (tem_u && tem_l){
+		for (int saida_u = 0; saida_u < 2; saida_u++){
+			int sai = saida_u ? u : l, volta = saida_u ? l : u;
+			if (f.dado[sai] != DICE_INICIAL)
+				continue;
+			fronteira g = f;
+			g.rotulo[u] = g.rotulo[l] = ROTULO_VAZIO;
+			if (f.rotulo[sai] == f.rotulo[volta]){
+				if (!fronteira_vazia(&g, p->plugs))
+					continue;
+				g.fechado = true;
+			}
+			else {
+				renomear(&g, p->plugs, f.rotulo[sai], ROTULO_SAIDA);
+				renomear(&g, p->plugs, f.rotulo[volta], ROTULO_VOLTA);
+			}
+			emitir(p, &g, dice_bottom[f.dado[volta]], 0);
+		}
+	}
+	else if (tem_u || tem_l){
+		int k = tem_u ? u : l;
+		int rotulo = f.rotulo[k], o = f.dado[k];
+		f.rotulo[k] = ROTULO_VAZIO;
+		for (int longa = 0; longa < 2; longa++){
+			if (!(longa ? p->pode_longa : p->pode_curta))
+				continue;
+			if (o == DICE_INICIAL){
+				//a aresta k eh a saida; a volta chega pela celula seguinte, com qualquer orientacao
+				fronteira g = f;
+				renomear(&g, p->plugs, rotulo, ROTULO_SAIDA);
+				for (int volta = 0; volta < 24; volta++){
+					fronteira h = g;
+					ligar(p, &h, longa, ROTULO_VOLTA, volta);
+					emitir(p, &h, dice_bottom[volta], longa ? ARESTA_LONGA : ARESTA_CURTA);
+				}
+			}
+			//a aresta k eh a volta; a saida vai para a celula seguinte
+			fronteira g = f;
+			renomear(&g, p->plugs, rotulo, ROTULO_VOLTA);
+			ligar(p, &g, longa, ROTULO_SAIDA, DICE_INICIAL);
+			emitir(p, &g, dice_bottom[o], longa ? ARESTA_LONGA : ARESTA_CURTA);
+		}
+	}
+	else if (p->pode_longa && p->pode_curta){
+		for (int saida_longa = 0; saida_longa < 2; saida_longa++){
+			for (int volta = 0; volta < 24; volta++){
+				fronteira g = f;
+				ligar(p, &g, saida_longa, ROTULO_SAIDA, DICE_INICIAL);
+				ligar(p, &g, !saida_longa, ROTULO_VOLTA, volta);
+				emitir(p, &g, dice_bottom[volta], ARESTA_LONGA | ARESTA_CURTA);
+			}
+		}
+	}
+}
+
+static void camada_liberar_busca(camada* c){
+	free(c->chave);
+	free(c->pontuacao);
+	free(c->tabela);
+}
+
+/*Anda pelo ciclo a partir da origem, comecando por 'primeiro'; grava o passeio e retorna a pontuacao*/
+static int percorrer(grid* g, const int* vizinhos, int origem, int primeiro, int total, int* passeio){
+	dice d = DICE_INICIAL;
+	int pontos = 0;
+	int anterior = origem, atual = primeiro;
+	for (int k = 0; k < total; k++){
+		passeio[k] = atual;
+		pontos += roll(&d, d, grid_direcao(g, atual, anterior));
+		int proximo = vizinhos[2*atual] == anterior ? vizinhos[2*atual+1] : vizinhos[2*atual];
+		anterior = atual;
+		atual = proximo;
+	}
+	return pontos;
+}
+
+static void ligar_vizinhos(int* vizinhos, int a, int b){
+	vizinhos[2*a + (vizinhos[2*a] >= 0)] = b;
+	vizinhos[2*b + (vizinhos[2*b] >= 0)] = a;
+}
+
+long long estimar_estados_fronteira(grid* g){
+	bool transposta = g->n < g->m;
+	int lado = transposta ? g->n : g->m;
+	int comprimento = transposta ? g->m : g->n;
+	if (lado > LADO_MAX_FRONTEIRA)
+		return LLONG_MAX;
+	const int* medidas = estados_por_linha[lado];
+	int qtd_medidas = 0;
+	while (qtd_medidas < MEDIDAS_POR_LADO && medidas[qtd_medidas] > 0)
+		qtd_medidas++;
+
+	long long estimativa = 0;
+	int seguidas = 0;
+	for (int a = 0; a < comprimento; a++){
+		bool tem_preta = false;
+		for (int b = 0; b < lado; b++){
+			tem_preta |= g->black[transposta ? grid_index(g, a, b) : grid_index(g, b, a)];
+		}
+		//uma linha com casas pretas obriga os fragmentos a se juntarem e corta a variedade de estados, sem zera-la
+		seguidas = tem_preta ? seguidas / 2 : seguidas + 1;
+		int k = seguidas < 1 ? 1 : seguidas > qtd_medidas ? qtd_medidas : seguidas;
+		estimativa += medidas[k-1];
+	}
+	return estimativa;
+}
+
+int resolver_por_fronteira(grid* g, int origem, int total, int* solucao){
+	estados_fronteira = 0;
+	bool transposta = g->n < g->m;//o lado menor fica ao longo das linhas do mapa
+	int lado = transposta ? g->n : g->m;
+	int comprimento = transposta ? g->m : g->n;
+	if (lado > LADO_MAX_FRONTEIRA || total < 4)
+		return -1;
+	//a estimativa erra para menos com casas pretas (ate ~4x nos mapas 6x6), entao so roda com folga para o limite
+	if (estimar_estados_fronteira(g) > LIMITE_ESTADOS_FRONTEIRA / 2)
+		return -1;
+
+	passo p;
+	p.plugs = lado + 1;
+	p.dir_longa = transposta ? ROLL_DOWN : ROLL_RIGHT;
+	p.dir_curta = transposta ? ROLL_RIGHT : ROLL_DOWN;
+	int celulas = lado*comprimento;
+	uint32_t** anteriores = (uint32_t**) calloc(celulas, sizeof(uint32_t*));
+	uint8_t** decisoes = (uint8_t**) calloc(celulas, sizeof(uint8_t*));
+	camada atual = {0};
+	camada_inserir(&atual, 0, 0, 0, 0);
+	uint32_t* anterior_inicial = atual.anterior;
+	uint8_t* decisao_inicial = atual.decisao;
+	long long guardados = 0;
+	bool excedido = false;
+
+	int s = 0;
+	for (int a = 0; a < comprimento && atual.qtd > 0 && !excedido; a++){
+		for (int b = 0; b < lado && atual.qtd > 0 && !excedido; b++, s++){
+			int idx = transposta ? grid_index(g, a, b) : grid_index(g, b, a);
+			bool livre = !g->black[idx];
+			camada prox = {0};
+			p.prox = &prox;
+			p.b = b;
+			p.origem = idx == origem;
+			//a borda preta da grade cobre o fim das linhas e do mapa
+			p.pode_longa = livre && !g->black[idx + g->deslocamento[p.dir_longa]];
+			p.pode_curta = livre && !g->black[idx + g->deslocamento[p.dir_curta]];
+			for (int e = 0; e < atual.qtd; e++){
+				fronteira f;
+				decodificar(atual.chave[e], &f, p.plugs);
+				p.anterior = (uint32_t) e;
+				p.pontuacao = atual.pontuacao[e];
+				if (!livre){
+					if (f.rotulo[b] == ROTULO_VAZIO && f.rotulo[lado] == ROTULO_VAZIO)
+						emitir(&p, &f, 0, 0);
+				}
+				else if (!f.fechado){
+					if (p.origem)
+						expandir_origem(&p, f);
+					else
+						expandir_celula(&p, f);
+				}
+			}
+			camada_liberar_busca(&atual);
+			anteriores[s] = prox.anterior;
+			decisoes[s] = prox.decisao;
+			atual = prox;
+			if (atual.qtd > estados_fronteira)
+				estados_fronteira = atual.qtd;
+			guardados += atual.qtd;
+			//desiste cedo se as camadas restantes, do tamanho desta, passariam do limite
+			excedido = guardados + (long long) atual.qtd*(celulas - s - 1) > LIMITE_ESTADOS_FRONTEIRA;
+		}
+	}
+
+	int pontuacao = excedido ? -1 : 0;
+	int final = -1;
+	for (int e = 0; e < atual.qtd && !excedido && s == celulas; e++){
+		if (atual.chave[e] == ESTADO_FECHADO)
+			final = e;
+	}
+	if (final >= 0){
+		//refaz as arestas escolhidas, da ultima celula para a primeira
+		int* vizinhos = (int*) malloc(sizeof(int)*2*g->tamanho);
+		memset(vizinhos, -1, sizeof(int)*2*g->tamanho);
+		int e = final;
+		for (int t = celulas - 1; t >= 0; t--){
+			int idx = transposta ? grid_index(g, t / lado, t % lado) : grid_index(g, t % lado, t / lado);
+			if (decisoes[t][e] & ARESTA_LONGA)
+				ligar_vizinhos(vizinhos, idx, idx + g->deslocamento[p.dir_longa]);
+			if (decisoes[t][e] & ARESTA_CURTA)
+				ligar_vizinhos(vizinhos, idx, idx + g->deslocamento[p.dir_curta]);
+			e = (int) anteriores[t][e];
+		}
+		//o estado final nao guarda o sentido; fica o de maior pontuacao (o outro so pontua menos ou igual)
+		int* reverso = (int*) malloc(sizeof(int)*total);
+		pontuacao = percorrer(g, vizinhos, origem, vizinhos[2*origem], total, solucao);
+		int pontuacao_reverso = percorrer(g, vizinhos, origem, vizinhos[2*origem+1], total, reverso);
+		if (pontuacao_reverso > pontuacao){
+			memcpy(solucao, reverso, sizeof(int)*total);
+			pontuacao = pontuacao_reverso;
+		}
+		free(reverso);
+		free(vizinhos);
+	}
+
+	camada_liberar_busca(&atual);
+	for (int t = 0; t < s; t++){
+		free(anteriores[t]);
+		free(decisoes[t]);
+	}
+	free(anteriores);
+	free(decisoes);
+	free(anterior_inicial);
+	free(decisao_inicial);
+	return pontuacao;
+}
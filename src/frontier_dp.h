@@ -0,0 +1,37 @@
+/*
+ * frontier_dp.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef FRONTIER_DP_H_
+#define FRONTIER_DP_H_
+
+#include "graph.h"
+
+#define LADO_MAX_FRONTEIRA 6//lado menor ate o qual o main tenta a programacao dinamica de fronteira
+#define LIMITE_ESTADOS_FRONTEIRA (1 << 25)//estados guardados (somando todas as camadas) antes de desistir
+
+/**Solver exato para mapas estreitos, por programacao dinamica de fronteira (perfil).
+ * As celulas sao processadas ao longo do lado maior, uma linha de largura 'lado menor' por vez. O estado eh
+ * a fronteira entre as celulas processadas e as demais: para cada aresta do passeio que a cruza, o fragmento
+ * de caminho a que ela pertence e a orientacao que o dado deve ter na celula do outro lado. A origem vira
+ * duas pontas (a saida, com o dado inicial, e a volta), entao a pontuacao de cada celula sai da orientacao
+ * dela, sem depender da ordem em que o passeio a visita.
+ * O tempo cresce linearmente com o lado maior (a quantidade de estados por camada so depende do lado menor).
+ * Grava o passeio otimo em 'solucao' (no formato de melhor_solucao, terminando na origem) e retorna a
+ * pontuacao, 0 se o mapa nao tem passeio, ou -1 se os estados excederam LIMITE_ESTADOS_FRONTEIRA. Se a
+ * estimativa ja passa da metade do limite, retorna -1 sem rodar (e estados_fronteira fica 0).
+ */
+int resolver_por_fronteira(grid* g, int origem, int total, int* solucao);
+
+/**Estimativa dos estados que a programacao dinamica guardaria no mapa, em O(mn): soma, por linha ao longo
+ * do lado maior, os estados medidos num mapa sem casas pretas com a mesma quantidade de linhas livres
+ * seguidas. Uma linha com casas pretas divide essa contagem por 2.
+ */
+long long estimar_estados_fronteira(grid* g);
+
+extern int estados_fronteira;//maior quantidade de estados numa camada, na ultima execucao
+
+#endif /* FRONTIER_DP_H_ */
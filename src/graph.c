@@ -5,4 +5,25 @@
  *      Author: Arthur
  */
 
+#include <stdlib.h>
+#include "graph.h"
 
+/* Aloca uma grade m x n com todas as celulas pretas; quem le o mapa libera as celulas livres.
+ * O array da grade anterior eh reaproveitado se ele for grande o bastante (g deve comecar zerada). */
+void init_grid(grid* g, int m, int n){
+	g->m = m;
+	g->n = n;
+	g->largura = n+2;
+	g->tamanho = (m+2)*(n+2);
+	g->deslocamento[ROLL_LEFT] = -1;
+	g->deslocamento[ROLL_UP] = -g->largura;
+	g->deslocamento[ROLL_RIGHT] = 1;
+	g->deslocamento[ROLL_DOWN] = g->largura;
+	if (g->black == NULL || g->tamanho > g->capacidade){
+		g->black = (bool*) realloc(g->black, sizeof(bool)*g->tamanho);
+		g->capacidade = g->tamanho;
+	}
+	for (int idx = 0; idx < g->tamanho; idx++){
+		g->black[idx] = true;
+	}
+}
@@ -15,16 +15,42 @@
  * Se um novo campo aumenta a velocidade de processamento do algoritmo,
  * este deve ser adicionado.
  */
-typedef struct v{
-	int i, j;
-	bool visited;
-	bool black;
-	int tmp;//valor usado no guloso, para fazer o swap dos melhores movimentos na hora de add os filhos
-	dice* d;//dado associado
-} vertex;
-
-
-
-
+/**Grade guardada de forma contigua, linha a linha, com uma borda de celulas pretas em volta.
+ * Assim os vizinhos de idx sao idx-1, idx-largura, idx+1 e idx+largura, sem testes de limite,
+ * e a direcao de um movimento sai da diferenca entre os indices.
+ * O que muda durante a busca (visitado, dado) fica em arrays paralelos de cada contexto.
+ */
+typedef struct g{
+	int m, n;//altura e largura do mapa, sem a borda
+	int largura;//n+2
+	int tamanho;//(m+2)*(n+2)
+	int capacidade;//celulas alocadas em black (a maior grade ja lida, no modo lote)
+	int deslocamento[4];//diferenca de indice para cada direcao: esq, cima, dir, baixo (ordem do dice.h)
+	bool* black;//celulas pretas, incluindo a borda
+} grid;
+
+void init_grid(grid* g, int m, int n);
+
+static inline int grid_index(grid* g, int i, int j){
+	return (i+1)*g->largura + (j+1);
+}
+
+static inline int grid_i(grid* g, int idx){
+	return idx / g->largura - 1;
+}
+
+static inline int grid_j(grid* g, int idx){
+	return idx % g->largura - 1;
+}
+
+/*Direcao (ROLL_LEFT, ROLL_UP, ROLL_RIGHT ou ROLL_DOWN) do movimento de pai para filho, ou -1 se nao forem vizinhos*/
+static inline int grid_direcao(grid* g, int filho, int pai){
+	int diferenca = filho - pai;
+	if (diferenca == -1) return ROLL_LEFT;
+	if (diferenca == -g->largura) return ROLL_UP;
+	if (diferenca == 1) return ROLL_RIGHT;
+	if (diferenca == g->largura) return ROLL_DOWN;
+	return -1;
+}
 
 #endif /* GRAPH_H_ */
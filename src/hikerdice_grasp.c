@@ -4,7 +4,7 @@
  Author      : Arthur
  Version     : 1
  Copyright   : WTFPL
- Description : Algoritmo guloso para a soluo do problema do Hiker Dice Hamiltoniano
+ Description : Algoritmo guloso para a solu��o do problema do Hiker Dice Hamiltoniano
 
  ============================================================================
  */
@@ -15,57 +15,115 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
-#include <float.h>
 #include <time.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
 #include "dice.h"
 #include "graph.h"
+#include "local_search.h"
+#include "upper_bound.h"
+#include "map_loader.h"
+#include "solution_output.h"
+#include "batch.h"
+#include "solution_cache.h"
+#include "tiled_constructor.h"
+#include "decomposition.h"
+#include "frontier_dp.h"
+#include "symmetry.h"
+#include "transposition.h"
+#include "work_stealing.h"
 
 /** ================================================= Data =================================*/
-vertex** matrix;//uma matriz
+grid grade;//grade lida do arquivo (somente leitura, compartilhada pelos contextos)
 
 int m_, n_;//altura e largura do grafo
 int total_free_vertexes;//total de vertices livres (nao pretos)
 
-vertex** stack;//pilha de busca do branch and bound
-int head_stack;//cabeca da pilha de busca
-
-vertex* origin;//vertice de saida
-vertex** melhor_solucao;//sequencia de vertices da melhor solucao (array de ponteiros)
-
-vertex** solucao_parcial;//sequencia de vertices da melhor solucao (array de ponteiros)
-int head_solucao_parcial;//cabeca da solucao parcial
+int origin_i, origin_j;//posicao do vertice de saida
+int* melhor_solucao;//sequencia de vertices (indices da grade) da melhor solucao
 
 int pontuacao_melhor_solucao;//Pontuacao da melhor solucao
-int pontuacao_parcial;//pontuacao parcial sendo construida
-int vertex_restantes;
-
-int *pontuacao_max_para_cada_numero_jogadas;
 
 //=============== parte do GRASP
-vertex*** solucoes_iniciais;//vetor para um vertex** (que por sua vez  um vetor de vertex*)
-int populacao_solucao_inicial;//tamanho da populao inicial
+int** solucoes_iniciais;//pool de elite: as melhores solucoes distintas (cada uma um vetor de indices da grade)
+int* pontuacao_elite;//pontuacao de cada solucao do pool
+int qtd_elite;//solucoes no pool
+int tamanho_elite = 8;//-k: capacidade do pool (0 desliga a religacao de caminhos)
+pthread_mutex_t trava_elite = PTHREAD_MUTEX_INITIALIZER;
+int populacao_solucao_inicial;//tamanho da popula��o inicial
+int qtd_threads;//quantidade de workers executando restarts em paralelo
+atomic_int pontuacao_incumbente;//melhor pontuacao entre todos os workers, usada na poda
+atomic_int proxima_solucao;//indice do proximo restart a ser executado
+uint64_t semente;//semente do gerador (-r); cada contexto usa um fluxo diferente do PCG
+bool semente_informada;
 //================fim da parte do GRASP
 
+//=============== modo exato (branch and bound semeado pelo GRASP)
+bool modo_exato;
+bool otimalidade_provada;
+unsigned long long limite_nos;//limite de vertices expandidos (0 = sem limite)
+double limite_segundos;//limite de tempo (0 = sem limite)
+double inicio_busca_exata;
+atomic_bool busca_exata_interrompida;//algum worker atingiu um limite (-n, -s) ou o prazo
+atomic_ullong nos_busca_exata;//vertices expandidos por todos os workers, somados a cada 1024
+contexto* contextos_exatos;//workers que dividem a arvore (vitimas dos roubos)
+int qtd_contextos_exatos;
+
+//=============== modo anytime (prazo de tempo de parede)
+double prazo_segundos;//-d: prazo da busca (0 = sem prazo)
+bool imprimir_incumbentes;//imprime cada melhora da incumbente com o tempo decorrido (-d fora do modo lote)
+double inicio_solve;
+double prazo_final;
+int limite_superior;//pontuacao maxima do passeio inteiro; atingida, nao ha o que melhorar
+atomic_bool busca_encerrada;//prazo expirado ou limite superior atingido
+
+//=============== cache de solucoes em disco
+char* diretorio_cache;//-c (acerto devolve a solucao) ou -C (acerto vira a primeira incumbente)
+bool refinar_cache;
+bool solucao_do_cache;//a solucao impressa veio do cache, sem busca
+
+//=============== construtor em blocos (mapas sem casas pretas)
+int pontuacao_construtor_blocos;//pontuacao do passeio construido em O(mn), 0 se o mapa nao se encaixa
+
+//=============== decomposicao em blocos (mapas grandes)
+int lado_decomposicao;//-B: lado aproximado dos blocos (0 = sem decomposicao)
+bool decomposicao_usada;//o passeio veio da costura dos blocos
+
+//=============== programacao dinamica de fronteira (mapas estreitos)
+int resultado_fronteira;//pontuacao otima (0 = sem passeio), -1 se nao foi usada ou excedeu o limite de estados
+
+//=============== saida do passeio completo
+char* arquivo_movimentos;//-o (texto) ou -b (binario)
+bool movimentos_binario;
+
 unsigned long long count_branches;
 unsigned long long qtd_solucoes_validas;
-unsigned long long qtd_bound_pontuacao_max;//qtd de retornos por pontuao mxima no pode melhorar
-unsigned long long qtd_bound_null_black_visited;//qtd de retornos por vrtice nulo ou prto ou visitado
+unsigned long long qtd_bound_pontuacao_max;//qtd de retornos por pontua��o m�xima n�o pode melhorar
+unsigned long long qtd_bound_null_black_visited;//qtd de retornos por v�rtice nulo ou prto ou visitado
 unsigned long long qtd_bound_grau_vizinho_1;//qtd de retornos por grau de algum vizinho == 1
-
-
-//parte da busca em profundidade p/ verificar a conexão do grafo
-int vertex_atingidos;
-vertex **vertex_visitados_profundidade;
+unsigned long long qtd_bound_desconexo;//qtd de retornos por desconectar os vertices livres
+unsigned long long qtd_bound_transposicao;//qtd de retornos por estado ja esgotado com pontuacao maior ou igual
+unsigned long long qtd_buscas_conexao;//qtd de vezes em que o teste local de conexao foi ambiguo
+unsigned long long qtd_movimentos_forcados;//qtd de vertices expandidos com um unico movimento possivel
+unsigned long long qtd_melhorias_busca_local;//qtd de inversoes aplicadas pela busca local
+unsigned long long qtd_melhorias_religacao;//qtd de vezes em que a religacao de caminhos melhorou a solucao do contexto
+unsigned long long qtd_melhorias_simetria;//qtd de vezes em que a imagem simetrica de um passeio melhorou a solucao do contexto
+unsigned long long qtd_ramos_roubados;//qtd de ramos do modo exato levados por um worker ocioso
+INSTR(instrumentacao instr_total;)//soma das estatisticas de todos os contextos
+char* arquivo_instrumentacao;//-j: exporta a instrumentacao em JSON
+int qtd_processos;//-p: processos resolvendo jobs em paralelo no modo lote
 
 /** ================================================= End Data =================================*/
 
 /*Resolve o mapa usando o grasp
  *
  *
- * O algoritmo ir verificar e escolher a melhor dentre as seguintes 9 solues
+ * O algoritmo ir� verificar e escolher a melhor dentre as seguintes 9 solu��es
  *
- * soluo gulosa baseada no vizinho com maior recompensa ('custo' da aresta)
- * soluo seguindo as seguintes sequncias de vizinhos de um vrtice, da rvore de busca
+ * solu��o gulosa baseada no vizinho com maior recompensa ('custo' da aresta)
+ * solu��o seguindo as seguintes sequ�ncias de vizinhos de um v�rtice, da �rvore de busca
  * esq - cima - direita - baixo
  * esq - baixo - direita - cima
  * cima - direita - baixo - esq
@@ -76,23 +134,23 @@ vertex **vertex_visitados_profundidade;
  * baixo - direita - cima - esquerda
  *
  *
- * Uma possvel variao  a insero de movimentos aleatrios
- * parmetros:
- * % taxa de aleatorizao (se vai escolher o prximo passo guloso ou aleatrio)
+ * Uma poss�vel varia��o � a inser��o de movimentos aleat�rios
+ * par�metros:
+ * % taxa de aleatoriza��o (se vai escolher o pr�ximo passo guloso ou aleat�rio)
  *
  *
- * Assim, as solues no compartilham uma vizinhana explicia a nivel de estrutura de dados
- * mas compartilhan a FORMA de construo da soluo.
+ * Assim, as solu��es n�o compartilham uma vizinhan�a explicia a nivel de estrutura de dados
+ * mas compartilhan a FORMA de constru��o da solu��o.
  *
  *
  *
  * */
 
 /*
- * 1passo: Gerar N solues guloso-aleatrias para posteriormente aplicar a busca local.
- * 			nessas N solues iniciais, as 17 primeiras sero:
- * 			soluo gulosa simples (sem aleatoriedade)
- * 			 soluo seguindo as seguintes ordens de preferncia de vizinhos de um vrtice, na rvore de busca
+ * 1�passo: Gerar N solu��es guloso-aleat�rias para posteriormente aplicar a busca local.
+ * 			nessas N solu��es iniciais, as 17 primeiras ser�o:
+ * 			solu��o gulosa simples (sem aleatoriedade)
+ * 			 solu��o seguindo as seguintes ordens de prefer�ncia de vizinhos de um v�rtice, na �rvore de busca
  * 			 esq - cima - direita - baixo
  * 			 esq - baixo - direita - cima
  * 			 cima - direita - baixo - esq
@@ -111,164 +169,536 @@ vertex **vertex_visitados_profundidade;
  * 			 baixo - cima - dir -esq
  */
 void solve(){
-	generate_greedy_solutions();
-
-}
-
-//Gera N solues semi-gulosas aleatrias
-//a cada vrtice vizitado, os seus vizinhos livres so hankeados de acordo com a pontuao que se obtem
-// feita uma roleta para decidir a ordem em que eles aparecero para ser add na pilha
-void generate_greedy_solutions(){
-	for (int solution = 0; solution < populacao_solucao_inicial; solution++){
-		reset_stack();
-		add_childs(origin, stack);
-		solucao_parcial[-1] = origin;
-		bool has_found_solution = false;
-
-		while (head_stack >= 0 && !has_found_solution){
-			vertex* actual = stack[head_stack];
-			if (!actual->visited){
-				actual->visited = true;
-				vertex_restantes--;
-				solucao_parcial[head_solucao_parcial++] = actual;
-				roll_dice(actual, solucao_parcial[head_solucao_parcial-2]);
-				add_childs(actual, stack);
+	static contexto* contextos = NULL;//reaproveitados entre os jobs do modo lote
+	if (contextos == NULL)
+		contextos = (contexto*) calloc(qtd_threads, sizeof(contexto));
+	pthread_t* threads = malloc(sizeof(pthread_t)*qtd_threads);
+
+	otimalidade_provada = false;
+	atomic_store(&pontuacao_incumbente, pontuacao_melhor_solucao);//0, ou a solucao do cache
+	atomic_store(&proxima_solucao, 0);
+	atomic_store(&busca_encerrada, false);
+	limite_superior = pontuacao_max(total_free_vertexes, DICE_INICIAL, DIRECAO_NENHUMA);
+	inicio_solve = relogio_monotonico();
+	prazo_final = inicio_solve + prazo_segundos;
+	tt_preparar(&grade, limite_superior);
+	for (int t = 0; t < qtd_threads; t++){
+		init_contexto(&contextos[t], semente, (uint64_t) t);
+	}
+
+	//mapas sem casas pretas: o passeio em blocos vira a primeira incumbente e entra no pool de elite
+	pontuacao_construtor_blocos = construir_passeio_em_blocos(&grade, contextos[0].origin, total_free_vertexes,
+			contextos[0].melhor_solucao);
+	if (pontuacao_construtor_blocos > 0){
+		contextos[0].pontuacao_melhor_solucao = pontuacao_construtor_blocos;
+		if (tamanho_elite > 0)
+			inserir_elite(contextos[0].melhor_solucao, pontuacao_construtor_blocos);
+		publicar_incumbente(pontuacao_construtor_blocos);
+	}
+
+	//o worker 0 roda na thread principal
+	for (int t = 1; t < qtd_threads; t++){
+		pthread_create(&threads[t], NULL, worker_grasp, &contextos[t]);
+	}
+	generate_greedy_solutions(&contextos[0]);
+	for (int t = 1; t < qtd_threads; t++){
+		pthread_join(threads[t], NULL);
+	}
+
+	if (modo_exato && !atomic_load(&busca_encerrada)){
+		otimalidade_provada = branch_and_bound(contextos, qtd_threads);
+	}
+	if (atomic_load(&pontuacao_incumbente) >= limite_superior)
+		otimalidade_provada = true;
+
+	merge_contextos(contextos, qtd_threads);
+	free(threads);
+}
+
+void* worker_grasp(void* arg){
+	generate_greedy_solutions((contexto*) arg);
+	return NULL;
+}
+
+//Gera N solu��es semi-gulosas aleat�rias
+//a cada v�rtice vizitado, os seus vizinhos livres s�o hankeados de acordo com a pontua��o que se obtem
+//� feita uma roleta para decidir a ordem em que eles aparecer�o para ser add na pilha
+//Os restarts s�o distribu�dos entre os workers atrav�s do contador compartilhado proxima_solucao
+void generate_greedy_solutions(contexto* c){
+	while (proximo_restart()){
+		unsigned long long encontradas = c->qtd_solucoes_validas;
+		reset_stack(c);
+		INSTR(instr_inicio_restart(&c->instr));
+		busca_em_profundidade(c, false);
+		INSTR(instr_fim_restart(&c->instr));
+		if (c->qtd_solucoes_validas > encontradas){
+			avaliar_simetrias(c);
+			if (tamanho_elite > 0)
+				religar_com_elite(c);
+		}
+	}
+}
+
+/**Insere a solucao no pool de elite se ela for distinta das que ja estao la e melhor que a pior
+ * (ou se o pool ainda nao estiver cheio). O pool eh compartilhado pelos workers.
+ */
+void inserir_elite(const int* solucao, int pontuacao){
+	size_t bytes = sizeof(int)*total_free_vertexes;
+	pthread_mutex_lock(&trava_elite);
+	int pior = -1;
+	bool repetida = false;
+	for (int k = 0; k < qtd_elite && !repetida; k++){
+		repetida = pontuacao_elite[k] == pontuacao && memcmp(solucoes_iniciais[k], solucao, bytes) == 0;
+		if (pior < 0 || pontuacao_elite[k] < pontuacao_elite[pior])
+			pior = k;
+	}
+	if (!repetida){
+		int destino = qtd_elite < tamanho_elite ? qtd_elite++ : (pontuacao > pontuacao_elite[pior] ? pior : -1);
+		if (destino >= 0){
+			memcpy(solucoes_iniciais[destino], solucao, bytes);
+			pontuacao_elite[destino] = pontuacao;
+		}
+	}
+	pthread_mutex_unlock(&trava_elite);
+}
+
+/**Religacao de caminhos entre a nova solucao do contexto e um membro sorteado do pool de elite,
+ * nos dois sentidos. O melhor intermediario passa pela busca local e volta para o pool,
+ * e se ele superar a solucao do contexto, vira a nova incumbente.
+ */
+void religar_com_elite(contexto* c){
+	pthread_mutex_lock(&trava_elite);
+	bool tem_parceiro = qtd_elite > 0;
+	if (tem_parceiro){
+		int k = (int) pcg32_limitado(&c->gerador, (uint32_t) qtd_elite);
+		memcpy(c->parceiro_elite, solucoes_iniciais[k], sizeof(int)*total_free_vertexes);
+	}
+	pthread_mutex_unlock(&trava_elite);
+	inserir_elite(c->melhor_solucao, c->pontuacao_melhor_solucao);
+	if (!tem_parceiro)
+		return;
+
+	for (int sentido = 0; sentido < 2; sentido++){
+		const int* inicio = sentido == 0 ? c->melhor_solucao : c->parceiro_elite;
+		const int* guia = sentido == 0 ? c->parceiro_elite : c->melhor_solucao;
+		if (religar_caminhos(c, inicio, guia, c->solucao_religada) == 0)
+			continue;
+		int pontuacao = busca_local(c, c->solucao_religada);
+		inserir_elite(c->solucao_religada, pontuacao);
+		if (pontuacao > c->pontuacao_melhor_solucao){
+			memcpy(c->melhor_solucao, c->solucao_religada, sizeof(int)*total_free_vertexes);
+			c->pontuacao_melhor_solucao = pontuacao;
+			c->qtd_melhorias_religacao++;
+			publicar_incumbente(pontuacao);
+		}
+	}
+}
+
+/**Imagens da solucao do contexto pelos automorfismos do mapa, nos dois sentidos: sao passeios validos
+ * de pontuacao diferente (o dado inicial nao eh simetrico). A melhor passa pela busca local e, se superar
+ * a solucao do contexto, vira a nova incumbente.
+ */
+void avaliar_simetrias(contexto* c){
+	if (melhor_imagem_simetrica(&grade, c->origin, c->melhor_solucao, total_free_vertexes,
+			c->solucao_simetrica, c->imagem_simetrica) == 0)
+		return;
+	int pontuacao = busca_local(c, c->solucao_simetrica);
+	if (tamanho_elite > 0)
+		inserir_elite(c->solucao_simetrica, pontuacao);
+	if (pontuacao > c->pontuacao_melhor_solucao){
+		memcpy(c->melhor_solucao, c->solucao_simetrica, sizeof(int)*total_free_vertexes);
+		c->pontuacao_melhor_solucao = pontuacao;
+		c->qtd_melhorias_simetria++;
+		publicar_incumbente(pontuacao);
+	}
+}
+
+/**Modo exato: branch and bound completo a partir da origem, partindo da incumbente do GRASP.
+ * Com mais de um contexto, a mesma arvore eh dividida entre as threads por roubo de trabalho (work_stealing.h).
+ * Retorna true se a arvore foi esgotada (a melhor solucao eh otima), ou false se algum limite foi atingido.
+ */
+bool branch_and_bound(contexto* contextos, int qtd_contextos){
+	inicio_busca_exata = relogio_monotonico();
+	atomic_store(&busca_exata_interrompida, false);
+	atomic_store(&nos_busca_exata, 0);
+	atomic_store(&workers_ocupados, 1);//o worker 0 comeca pela raiz
+	contextos_exatos = contextos;
+	qtd_contextos_exatos = qtd_contextos;
+	busca_paralela = qtd_contextos > 1;
+	for (int t = 0; t < qtd_contextos; t++){
+		reset_stack(&contextos[t]);
+		preparar_roubo(&contextos[t]);
+	}
+
+	pthread_t* threads = malloc(sizeof(pthread_t)*qtd_contextos);
+	for (int t = 1; t < qtd_contextos; t++){
+		pthread_create(&threads[t], NULL, worker_exato, &contextos[t]);
+	}
+	worker_exato(&contextos[0]);
+	for (int t = 1; t < qtd_contextos; t++){
+		pthread_join(threads[t], NULL);
+	}
+	free(threads);
+	busca_paralela = false;
+	return !atomic_load(&busca_exata_interrompida);
+}
+
+/**Worker do modo exato: o worker 0 explora a arvore a partir da raiz, e os ociosos roubam o ramo mais raso
+ * de uma vitima sorteada, ate que nenhum worker tenha trabalho (a arvore foi esgotada) ou um limite seja atingido.
+ */
+void* worker_exato(void* arg){
+	contexto* c = (contexto*) arg;
+	INSTR(instr_inicio_restart(&c->instr));
+	bool esgotado = true;
+	if (c == &contextos_exatos[0]){
+		esgotado = busca_em_profundidade(c, true);
+		atomic_fetch_sub(&workers_ocupados, 1);
+	}
+	while (esgotado && atomic_load(&workers_ocupados) > 0 && !atomic_load(&busca_exata_interrompida)){
+		contexto* vitima = &contextos_exatos[pcg32_limitado(&c->gerador, (uint32_t) qtd_contextos_exatos)];
+		if (vitima == c || !roubar_ramo(c, vitima)){
+			sched_yield();
+			continue;
+		}
+		c->qtd_ramos_roubados++;
+		esgotado = explorar_pilha(c, true);
+		atomic_fetch_sub(&workers_ocupados, 1);
+	}
+	if (!esgotado)
+		atomic_store(&busca_exata_interrompida, true);
+	INSTR(instr_fim_restart(&c->instr));
+	return NULL;
+}
+
+/**Decide se um worker faz mais um restart: ate esgotar a populacao, ou, com prazo (-d) e populacao 0,
+ * ate o prazo expirar. O prazo e o limite superior atingido encerram a busca em qualquer caso.
+ */
+bool proximo_restart(){
+	if (busca_deve_parar())
+		return false;
+	if (prazo_segundos > 0 && populacao_solucao_inicial <= 0)
+		return true;
+	return atomic_fetch_add(&proxima_solucao, 1) < populacao_solucao_inicial;
+}
+
+/*Prazo expirado ou incumbente igual ao limite superior (a busca nao tem mais o que melhorar)*/
+bool busca_deve_parar(){
+	if (atomic_load_explicit(&busca_encerrada, memory_order_relaxed))
+		return true;
+	if (prazo_segundos > 0 && relogio_monotonico() >= prazo_final){
+		atomic_store(&busca_encerrada, true);
+		return true;
+	}
+	return false;
+}
+
+/*Verifica os limites de nos e de tempo do modo exato (0 = sem limite)*/
+bool limite_busca_exata_atingido(unsigned long long nos){
+	if (busca_paralela){
+		//os workers somam os seus nos ao total a cada 1024, e o primeiro que atingir um limite para os demais
+		if (nos % 1024 != 0)
+			return false;
+		if (atomic_load_explicit(&busca_exata_interrompida, memory_order_relaxed))
+			return true;
+		nos = atomic_fetch_add(&nos_busca_exata, 1024) + 1024;
+	}
+	if (limite_nos > 0 && nos >= limite_nos)
+		return true;
+	if (limite_segundos > 0 && nos % 1024 == 0){
+		return relogio_monotonico() - inicio_busca_exata >= limite_segundos;
+	}
+	return false;
+}
+
+/**Busca em profundidade a partir da origem, usando a pilha do contexto.
+ * No GRASP a busca para na primeira solucao que melhora a incumbente; no modo exato ela continua
+ * ate esgotar a arvore, ou ate atingir um dos limites. Retorna true se a arvore foi esgotada.
+ */
+bool busca_em_profundidade(contexto* c, bool exata){
+	add_childs(c, c->origin);
+	c->solucao_parcial[-1] = c->origin;
+	if (busca_paralela)
+		publicar_topo(c);
+	return explorar_pilha(c, exata);
+}
+
+/*Laco da busca em profundidade sobre a pilha do contexto, ate esvazia-la (ou parar antes)*/
+bool explorar_pilha(contexto* c, bool exata){
+	unsigned long long nos = 0;
+	while (c->head_stack >= 0){
+		int actual = c->stack[c->head_stack];
+		if (actual == RAMO_ROUBADO){
+			c->head_stack--;
+			liberar_topo(c);
+			continue;
+		}
+		if (!c->visited[actual]){
+			//o prazo e o limite superior interrompem tambem um restart longo, verificados a cada 1024 nos
+			if (++nos % 1024 == 0 && busca_deve_parar())
+				return false;
+			if (exata && limite_busca_exata_atingido(nos))
+				return false;
+			visitar(c, actual);
+			c->vertex_restantes--;
+			atomic_store_explicit(&c->posicao_caminho[c->head_solucao_parcial], c->head_stack, memory_order_relaxed);
+			c->solucao_parcial[c->head_solucao_parcial++] = actual;
+			INSTR(instr_expansao(&c->instr, c->head_solucao_parcial));
+			roll_dice(c, actual, c->solucao_parcial[c->head_solucao_parcial-2]);
+			//estado ja esgotado com pontuacao maior ou igual: fica na pilha como visitado e sai na proxima iteracao
+			if (transposicao_ativa && tt_dominado(tt_chave(c->hash_visitadas, actual, c->dado[actual]), c->pontuacao_parcial)){
+				c->qtd_bound_transposicao++;
+				INSTR(instr_poda(&c->instr, PODA_TRANSPOSICAO, c->head_solucao_parcial));
+				continue;
 			}
-			else{
-				if (head_solucao_parcial == total_free_vertexes && pontuacao_melhor_solucao < pontuacao_parcial){
-					for (int i = 0; i < total_free_vertexes; i++){
-						melhor_solucao[i] = solucao_parcial[i];
-					}
-					pontuacao_melhor_solucao = pontuacao_parcial;
-					qtd_solucoes_validas++;
-					has_found_solution = true;
-					continue;
+			add_childs(c, actual);
+			if (busca_paralela)
+				publicar_topo(c);
+		}
+		else{
+			if (c->head_solucao_parcial == total_free_vertexes
+					&& atomic_load_explicit(&pontuacao_incumbente, memory_order_relaxed) < c->pontuacao_parcial){
+				for (int i = 0; i < total_free_vertexes; i++){
+					c->melhor_solucao[i] = c->solucao_parcial[i];
 				}
+				c->pontuacao_melhor_solucao = busca_local(c, c->melhor_solucao);
+				publicar_incumbente(c->pontuacao_melhor_solucao);
+				c->qtd_solucoes_validas++;
+				INSTR(instr_passeio(&c->instr));
+				if (!exata)
+					return true;
+			}
+
+			//avaliar_melhor_solucao();
+			INSTR(c->instr.backtracks++);
+			//a subarvore foi esgotada por este contexto (uma parada antecipada retorna antes de chegar aqui)
+			if (transposicao_ativa && subarvore_propria(c, c->head_stack))
+				tt_gravar(tt_chave(c->hash_visitadas, actual, c->dado[actual]), c->pontuacao_parcial);
+			desvisitar(c, actual);
+			c->pontuacao_parcial -= dice_bottom[c->dado[actual]];
+			if (actual == c->origin)//o retorno a origem sobrescreveu o dado inicial, que os filhos da raiz ainda rolam
+				c->dado[actual] = DICE_INICIAL;
+			c->head_solucao_parcial--;
+			atomic_store_explicit(&c->posicao_caminho[c->head_solucao_parcial], INT_MAX, memory_order_relaxed);
+			c->vertex_restantes++;
+			c->head_stack--;
+			if (busca_paralela)
+				liberar_topo(c);
+		}
+	}
+	return true;
+}
 
-				//avaliar_melhor_solucao();
-				actual->visited = false;
-				pontuacao_parcial -= actual->d->bottom;
-				head_stack--;
-				head_solucao_parcial--;
-				vertex_restantes++;
+/**Atualiza a pontuacao incumbente compartilhada, caso 'pontuacao' seja maior (sem locks)*/
+void publicar_incumbente(int pontuacao){
+	int atual = atomic_load(&pontuacao_incumbente);
+	while (atual < pontuacao){
+		if (atomic_compare_exchange_weak(&pontuacao_incumbente, &atual, pontuacao)){
+			if (imprimir_incumbentes){
+				printf("[%10.3fs] Nova incumbente: %d\n", relogio_monotonico() - inicio_solve, pontuacao);
+				fflush(stdout);
 			}
+			if (pontuacao >= limite_superior)
+				atomic_store(&busca_encerrada, true);
+			return;
 		}
 	}
 }
 
 /**Conta a quantidade de vizinhos livres de vtx, excluindo o atual*/
-int count_vizinhos_livres(vertex *vtx, vertex* atual){
-	int i = (*vtx).i;
-	int j = (*vtx).j;
+int count_vizinhos_livres(contexto* c, int vtx, int atual){
 	int count = 0;
-	if (j>0 && (&matrix[i][j-1] == origin
-			|| (!matrix[i][j-1].visited && !matrix[i][j-1].black && &matrix[i][j-1] != atual) ))
-		count++;
-	if (i>0 && (&matrix[i-1][j] == origin
-			|| (!matrix[i-1][j].visited && !matrix[i-1][j].black && &matrix[i-1][j] != atual) ))
-		count++;
-	if (j<n_-1 && (&matrix[i][j+1] == origin
-			|| (!matrix[i][j+1].visited && !matrix[i][j+1].black && &matrix[i][j+1] != atual) ))
-		count++;
-	if (i<m_-1 && (&matrix[i+1][j] == origin
-			|| (!matrix[i+1][j].visited && !matrix[i+1][j].black && &matrix[i+1][j] != atual) ))
-		count++;
+	for (int d = 0; d < 4; d++){
+		int v = vtx + grade.deslocamento[d];
+		if (v == c->origin || (!c->visited[v] && !grade.black[v] && v != atual))
+			count++;
+	}
 	return count;
 }
 
-/* Verifica se apos a insercao do next, os vizinhos do vertice atual continuam com grau 2,
- * excluindo o vertice vizinho que tambem eh vizinho do destino.
+/**Marca vtx como visitado, atualizando o grau livre dos seus vizinhos em O(1).
+ * A origem sempre conta como vizinho livre (o passeio termina nela), entao nao altera os graus.
  */
-bool vizinhos_atual_tem_grau_2_apos_insercao_next(vertex *atual, vertex *next, vertex *esq, vertex *cima, vertex *dir, vertex *baixo){
-	if (atual == origin)
-		return true;
+void visitar(contexto* c, int vtx){
+	c->visited[vtx] = true;
+	if (transposicao_ativa)
+		c->hash_visitadas ^= zobrist_visitada[vtx];
+	if (vtx != c->origin){
+		for (int d = 0; d < 4; d++)
+			c->grau_livre[vtx + grade.deslocamento[d]]--;
+	}
+}
 
-	if (esq != NULL && !esq->black && !esq->visited
-			&& esq != next && esq != origin && count_vizinhos_livres(esq, atual) < 2)
-		return false;
-	if (cima != NULL && !cima->black && !cima->visited
-			&& cima != next && cima != origin && count_vizinhos_livres(cima, atual) < 2)
-		return false;
-	if (dir != NULL && !dir->black && !dir->visited
-			&& dir != next && dir != origin && count_vizinhos_livres(dir, atual) < 2)
-		return false;
-	if (baixo != NULL && !baixo->black && !baixo->visited
-			&& baixo != next && baixo != origin && count_vizinhos_livres(baixo, atual) < 2)
-		return false;
-	return true;
+void desvisitar(contexto* c, int vtx){
+	c->visited[vtx] = false;
+	if (transposicao_ativa)
+		c->hash_visitadas ^= zobrist_visitada[vtx];
+	if (vtx != c->origin){
+		for (int d = 0; d < 4; d++)
+			c->grau_livre[vtx + grade.deslocamento[d]]++;
+	}
 }
 
-bool pontuacao_atual_pode_melhorar(){
-	int pontuacao_max = pontuacao_max_para_cada_numero_jogadas[vertex_restantes];
-	return ((pontuacao_max + pontuacao_parcial) > pontuacao_melhor_solucao);
+/* Um vizinho livre do atual (ja visitado) que ficou com grau livre < 2 so pode entrar no passeio
+ * se o proximo movimento for para ele: depois disso ele perderia o atual e ficaria sem saida.
+ * Retorna esse vizinho (movimento forcado), SEM_FORCADO, ou BECO_SEM_SAIDA quando ha mais de um
+ * vizinho nessa situacao, ou quando a origem ficou sem vizinho livre para o retorno.
+ */
+int vizinho_forcado(contexto* c, int atual){
+	if (atual == c->origin)
+		return SEM_FORCADO;
+	if (c->grau_livre[c->origin] == 0 && c->vertex_restantes > 1)
+		return BECO_SEM_SAIDA;
+
+	int forcado = SEM_FORCADO;
+	for (int d = 0; d < 4; d++){
+		int v = atual + grade.deslocamento[d];
+		if (!grade.black[v] && !c->visited[v] && v != c->origin && c->grau_livre[v] < 2){
+			if (forcado != SEM_FORCADO)
+				return BECO_SEM_SAIDA;
+			forcado = v;
+		}
+	}
+	return forcado;
 }
 
+/**A poda usa a melhor pontuacao de todos os workers, e nao somente a deste contexto*/
+/**O limite considera a rolagem para o next e, a partir dela, a tabela exata da orientacao resultante*/
+bool pontuacao_atual_pode_melhorar(contexto* c, int atual, int next){
+	int direcao = grid_direcao(&grade, next, atual);
+	dice rolado;
+	int pontos = roll(&rolado, c->dado[atual], direcao);
+	int limite = pontos + pontuacao_max(c->vertex_restantes-1, rolado, direcao);
+	int incumbente = atomic_load_explicit(&pontuacao_incumbente, memory_order_relaxed);
+	return ((limite + c->pontuacao_parcial) > incumbente);
+}
 
 
-void busca_profundidade(vertex *vtx){
-	int i = (*vtx).i;
-	int j = (*vtx).j;
-	vtx->visited = true;
-	vertex_visitados_profundidade[vertex_atingidos++] = vtx;
 
-	vertex * next = NULL;
-	if (j > 0) next = &matrix[i][j-1]; else next = NULL;
-	if (next != NULL && !next->visited && !next->black){
-		busca_profundidade(next);
-	}
-	if (i>0) next = &matrix[i-1][j]; else next = NULL;
-	if (next != NULL && !next->visited && !next->black){
-		busca_profundidade(next);
+static inline bool livre(contexto* c, int vtx){
+	return !grade.black[vtx] && !c->visited[vtx];
+}
+
+/**Busca em largura iterativa (sem recursao, para nao estourar a pilha do C em grades grandes),
+ * com o next bloqueado, partindo de todos os alvos ao mesmo tempo. Cada celula recebe o rotulo do
+ * alvo que a alcancou primeiro; quando duas frentes se encontram os seus grupos sao unidos.
+ * Termina quando sobra um unico grupo (conectado) ou quando algum grupo fica sem fronteira
+ * (desconectado), entao o custo fica proporcional ao menor componente, e nao a grade inteira.
+ * As marcas sao relativas a uma base que avanca a cada busca, entao nao precisam ser limpas.
+ */
+bool busca_largura_conexao(contexto* c, int next, int* alvos, int qtd_alvos){
+	if (c->geracao_marca > UINT_MAX - 8){
+		for (int idx = 0; idx < grade.tamanho; idx++)
+			c->marca[idx] = 0;
+		c->geracao_marca = 0;
 	}
-	if (j < n_-1) next = &matrix[i][j+1]; else next = NULL;
-	if (next != NULL && !next->visited && !next->black){
-		busca_profundidade(next);
+	unsigned int base = (c->geracao_marca += 8);
+	int grupo[4];
+	int pendentes[4];
+	int qtd_grupos = qtd_alvos;
+	int* fila = c->pilha_conexao;
+	int head = 0, tail = 0;
+
+	for (int k = 0; k < qtd_alvos; k++){
+		grupo[k] = k;
+		pendentes[k] = 1;
+		c->marca[alvos[k]] = base + k;
+		fila[tail++] = alvos[k];
 	}
-	if (i < m_-1) next = &matrix[i+1][j]; else next = NULL;
-	if (next != NULL && !next->visited && !next->black){
-		busca_profundidade(next);
+	while (head < tail){
+		int vtx = fila[head++];
+		int k = c->marca[vtx] - base;
+		pendentes[k]--;
+		for (int d = 0; d < 4; d++){
+			int w = vtx + grade.deslocamento[d];
+			if (w == next || !livre(c, w))
+				continue;
+			if (c->marca[w] >= base && c->marca[w] < base + qtd_alvos){
+				int g1 = grupo[k], g2 = grupo[c->marca[w] - base];
+				if (g1 != g2){
+					for (int j = 0; j < qtd_alvos; j++)
+						if (grupo[j] == g2) grupo[j] = g1;
+					if (--qtd_grupos == 1)
+						return true;
+				}
+				continue;
+			}
+			c->marca[w] = base + k;
+			fila[tail++] = w;
+			pendentes[k]++;
+		}
+		int pendentes_grupo = 0;
+		for (int j = 0; j < qtd_alvos; j++)
+			if (grupo[j] == grupo[k]) pendentes_grupo += pendentes[j];
+		if (pendentes_grupo == 0)
+			return false;
 	}
+	return false;
 }
 
 /**
- * Verifica se o grafo est conectado. fazendo uma busca em profundidade, e contando a quantidade de
- * vrtices alcanados.
+ * Verifica se o grafo continua conectado apos a insercao do next.
+ * Primeiro olha so o anel 3x3 em volta do next: as celulas livres consecutivas do anel sao conectadas
+ * entre si, entao se todos os vizinhos livres do next estao numa mesma sequencia o next nao separa nada.
+ * Quando ha mais de uma sequencia o teste local eh ambiguo, e uma busca verifica se elas se encontram
+ * por outro caminho. Como a regiao livre ja era conectada antes, isso basta.
  */
-bool grafo_conectado(vertex *next, vertex* atual){
-	int vizinhos_livres = count_vizinhos_livres(next, atual);
-	if (vizinhos_livres == 1) return true;
-	//else if () Verificar o caso em que tem grau 2 ou 3
-	vertex_atingidos = 0;
-
-	busca_profundidade(next);
-
-	//Desmarcando os visitados
-	for (int i = 0; i < vertex_atingidos; i++){
-		vertex_visitados_profundidade[i]->visited = false;
+bool grafo_conectado(contexto* c, int next){
+	int L = grade.largura;
+	int anel[8] = {-L, -L+1, 1, L+1, L, L-1, -1, -L-1};//N, NE, L, SE, S, SO, O, NO (pares sao ortogonais)
+
+	int inicio = -1;
+	for (int k = 0; k < 8 && inicio < 0; k++){
+		if (!livre(c, next + anel[k]))
+			inicio = k;
 	}
+	if (inicio < 0)
+		return true;
 
-	return (vertex_atingidos == total_free_vertexes - head_solucao_parcial);
+	//cada sequencia de celulas livres do anel que toca um vizinho ortogonal vira um alvo da busca
+	int alvos[4];
+	int qtd_alvos = 0;
+	int ortogonal_da_sequencia = -1;
+	for (int p = 1; p <= 8; p++){
+		int k = (inicio + p) % 8;
+		int vtx = next + anel[k];
+		if (livre(c, vtx)){
+			if (k % 2 == 0 && ortogonal_da_sequencia < 0)
+				ortogonal_da_sequencia = vtx;
+		}
+		else if (ortogonal_da_sequencia >= 0){
+			alvos[qtd_alvos++] = ortogonal_da_sequencia;
+			ortogonal_da_sequencia = -1;
+		}
+	}
+	if (qtd_alvos <= 1)
+		return true;
 
+	c->qtd_buscas_conexao++;
+	return busca_largura_conexao(c, next, alvos, qtd_alvos);
 }
 
 /* Verifica as condicoees de insercao do next*/
-bool insert_conditions(vertex *atual, vertex *next, vertex *esq, vertex *cima, vertex *dir, vertex *baixo){
-	if (next == NULL || next->black || next->visited || (next == origin && vertex_restantes > 1)){
-		qtd_bound_null_black_visited++;
+bool insert_conditions(contexto* c, int atual, int next, int forcado){
+	if (grade.black[next] || c->visited[next] || (next == c->origin && c->vertex_restantes > 1)){
+		c->qtd_bound_null_black_visited++;
+		INSTR(instr_poda(&c->instr, PODA_PRETO_VISITADO, c->head_solucao_parcial));
 		return false;
 	}
-	if (!pontuacao_atual_pode_melhorar()){
-		qtd_bound_pontuacao_max++;
+	if (!pontuacao_atual_pode_melhorar(c, atual, next)){
+		c->qtd_bound_pontuacao_max++;
+		INSTR(instr_poda(&c->instr, PODA_PONTUACAO, c->head_solucao_parcial));
 		return false;
 	}
-	if (!vizinhos_atual_tem_grau_2_apos_insercao_next(atual, next, esq, cima, dir, baixo)){
-		qtd_bound_grau_vizinho_1++;
+	if (forcado == BECO_SEM_SAIDA || (forcado != SEM_FORCADO && next != forcado)){
+		c->qtd_bound_grau_vizinho_1++;
+		INSTR(instr_poda(&c->instr, PODA_GRAU, c->head_solucao_parcial));
+		return false;
+	}
+	if (next != c->origin && !grafo_conectado(c, next)){
+		c->qtd_bound_desconexo++;
+		INSTR(instr_poda(&c->instr, PODA_DESCONEXO, c->head_solucao_parcial));
 		return false;
 	}
-	//if (!grafo_conectado(next, atual)){
-	//	return false;
-	//}
-
 
 	return true;
 }
@@ -279,73 +709,61 @@ bool insert_conditions(vertex *atual, vertex *next, vertex *esq, vertex *cima, v
  */
 
 /*Adiciona os filhos de 'atual', aplicando uma ordem gulosa que tenta escolher os mais bem aptos em cada sorteio.
- * No fim, essa ordem  revertida, j que o ultimo adicionado ser o primeiro da cabea da pilha
+ * No fim, essa ordem � revertida, j� que o ultimo adicionado ser� o primeiro da cabe�a da pilha
  */
-void add_childs(vertex* atual, vertex** stack){
-	int i = (*atual).i;
-	int j = (*atual).j;
-	vertex *vizinhoEsq = NULL;
-	vertex *vizinhoCima = NULL;
-	vertex *vizinhoDir = NULL;
-	vertex *vizinhoBaixo = NULL;
-	if (j>0) vizinhoEsq = &matrix[i][j-1];
-	if (i>0) vizinhoCima = &matrix[i-1][j];
-	if (j<n_-1) vizinhoDir = &matrix[i][j+1];
-	if (i<m_-1) vizinhoBaixo = &matrix[i+1][j];
-
-	int first_new_vtx = head_stack+1;//guarda a posio do primeiro novo elemento inserid
-
-	if (insert_conditions(atual, vizinhoEsq, vizinhoEsq, vizinhoCima, vizinhoDir, vizinhoBaixo)){
-		stack[++head_stack] = vizinhoEsq;
-		count_branches++;
-	}
-	if (insert_conditions(atual, vizinhoCima, vizinhoEsq, vizinhoCima, vizinhoDir, vizinhoBaixo)){
-		stack[++head_stack] = vizinhoCima;
-		count_branches++;
-	}
-	if (insert_conditions(atual, vizinhoDir, vizinhoEsq, vizinhoCima, vizinhoDir, vizinhoBaixo)){
-		stack[++head_stack] = vizinhoDir;
-		count_branches++;
-	}
-	if (insert_conditions(atual, vizinhoBaixo, vizinhoEsq, vizinhoCima, vizinhoDir, vizinhoBaixo)){
-		stack[++head_stack] = vizinhoBaixo;
-		count_branches++;
-	}
-
-	//================================ Mecanismo de ordenao guloso-aleatrio========================
+void add_childs(contexto* c, int atual){
+	int* stack = c->stack;
+
+	int first_new_vtx = c->head_stack+1;//guarda a posi��o do primeiro novo elemento inserid
+
+	int forcado = vizinho_forcado(c, atual);
+	if (forcado >= 0)
+		c->qtd_movimentos_forcados++;
+
+	for (int d = 0; d < 4; d++){
+		int next = atual + grade.deslocamento[d];
+		if (insert_conditions(c, atual, next, forcado)){
+			stack[++c->head_stack] = next;
+			c->count_branches++;
+		}
+	}
+
+	//================================ Mecanismo de ordenacao guloso-aleatorio========================
+	//Roleta inteira sem reposicao: o peso de cada filho eh a sua pontuacao menos a menor pontuacao, mais 1.
+	//Cada sorteio escolhe um filho ainda nao selecionado, entao sao sempre qtd_inseridos-1 sorteios.
+	int head_stack = c->head_stack;
 	int qtd_inseridos = head_stack - (first_new_vtx-1);
 	if (first_new_vtx > 0 && qtd_inseridos > 1){
-		float menor_valor_ponto = FLT_MAX;
-		float pontuacao[4] = {0};//pontuao do vtx i, de acordo com a ordem de leitura.
-		bool selecionados[4] = {0};
-		float acc_pontuacao = 0;//acumulador da pontuacao
-		vertex* subLista[4] = {0};
-		int count_selecionados = 0;
-
-		for (int i = first_new_vtx; i <= head_stack; i++){
-			pontuacao[i-first_new_vtx] = fake_roll_dice(stack[i], stack[first_new_vtx-1]);
-			if (pontuacao[i-first_new_vtx] < menor_valor_ponto)
-				menor_valor_ponto = pontuacao[i-first_new_vtx];//pegando o menor valor
-			acc_pontuacao += pontuacao[i-first_new_vtx];//pegando o acumulador
+		int menor_valor_ponto = INT_MAX;
+		int pontuacao[4] = {0};//peso do vtx i, de acordo com a ordem de leitura.
+		int candidatos[4] = {0};
+		int acc_pontuacao = 0;//soma dos pesos dos candidatos ainda nao selecionados
+		int subLista[4] = {0};
+
+		for (int i = 0; i < qtd_inseridos; i++){
+			candidatos[i] = stack[first_new_vtx+i];
+			pontuacao[i] = fake_roll_dice(c, candidatos[i], stack[first_new_vtx-1]);
+			if (pontuacao[i] < menor_valor_ponto)
+				menor_valor_ponto = pontuacao[i];
 		}
-		float diferenca = menor_valor_ponto - 1;//depois de calcular a diferena, d pra subtrair as pontuaes
-		acc_pontuacao -= diferenca*qtd_inseridos;
-		for (int i = first_new_vtx; i <= head_stack; i++){
-			pontuacao[i-first_new_vtx] -= diferenca;//subtrai todos os pontos pra aproximar de 0 e maximizar as diferenas
-			pontuacao[i-first_new_vtx] = pontuacao[i-first_new_vtx] / acc_pontuacao;//agora temos a % de cada vtx
+		for (int i = 0; i < qtd_inseridos; i++){
+			pontuacao[i] -= menor_valor_ponto - 1;//aproxima de 0 para maximizar as diferencas
+			acc_pontuacao += pontuacao[i];
 		}
-		while (count_selecionados < qtd_inseridos){
-			float sorteado = ((double)rand()/(double)RAND_MAX);
-			float acc_porcentagem = 0;//acumula as porcentagens para dar o 'pedao da roleta'
-			for (int i = first_new_vtx; i <= head_stack && count_selecionados < qtd_inseridos; i++){
-				acc_porcentagem += pontuacao[i-first_new_vtx];
-				if (sorteado < acc_porcentagem && !selecionados[i-first_new_vtx]){
-					subLista[count_selecionados] = stack[i];
-					selecionados[i-first_new_vtx] = 1;
-					count_selecionados++;
-				}
+		for (int restantes = qtd_inseridos; restantes > 1; restantes--){
+			int sorteado = (int) pcg32_limitado(&c->gerador, (uint32_t) acc_pontuacao);
+			int i = 0;
+			while (sorteado >= pontuacao[i]){
+				sorteado -= pontuacao[i];
+				i++;
 			}
+			subLista[qtd_inseridos-restantes] = candidatos[i];
+			acc_pontuacao -= pontuacao[i];
+			//remove o selecionado trazendo o ultimo candidato para a sua posicao
+			candidatos[i] = candidatos[restantes-1];
+			pontuacao[i] = pontuacao[restantes-1];
 		}
+		subLista[qtd_inseridos-1] = candidatos[0];
 
 		//no fim, copia em ordem reversa pra pilha
 		for (int i = first_new_vtx; i <= head_stack; i++){
@@ -357,99 +775,203 @@ void add_childs(vertex* atual, vertex** stack){
 
 
 
-//Rolando o dado para o actualVertex
-void roll_dice(vertex* actualVertex, vertex* vertexPai){
-	if (vertexPai != NULL){
-		dice *dadoAtual = (*actualVertex).d;
-		dice *dadoPai = (*vertexPai).d;
-		if (relacaoPaiFilho(actualVertex, vertexPai) == 1){
-			pontuacao_parcial += roll_left(dadoAtual,dadoPai);//rolando o dado que ja esta no proximo vertice
-		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 2){
-			pontuacao_parcial += roll_up(dadoAtual, dadoPai);//rolando o dado que ja esta no proximo vertice
-		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 3){
-			pontuacao_parcial += roll_right(dadoAtual, dadoPai);//rolando o dado que ja esta no proximo vertice
-		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 4){
-			pontuacao_parcial += roll_down(dadoAtual, dadoPai);//rolando o dado que ja esta no proximo vertice
-		}
-	}
+//Rolando o dado para o actualVertex. A direcao vem da diferenca entre os indices
+void roll_dice(contexto* c, int actualVertex, int vertexPai){
+	c->pontuacao_parcial += roll(&c->dado[actualVertex], c->dado[vertexPai], grid_direcao(&grade, actualVertex, vertexPai));
+}
+
+//Pontuacao que o actualVertex receberia se o dado do vertexPai rolasse para ele, sem alterar nenhum dado
+int fake_roll_dice(contexto* c, int actualVertex, int vertexPai){
+	return fake_roll(c->dado[vertexPai], grid_direcao(&grade, actualVertex, vertexPai));
 }
 
-//Rolando o dado para o actualVertex
-int fake_roll_dice(vertex* actualVertex, vertex* vertexPai){
-	if (vertexPai != NULL){
-		int pontuacao = 0;
-		dice *dadoAtual = (*actualVertex).d;
-		dice *dadoPai = (*vertexPai).d;
-		if (relacaoPaiFilho(actualVertex, vertexPai) == 1){
-			pontuacao = fake_roll_left(dadoAtual, dadoPai);
+
+/*Le as opcoes a partir de argv[inicio]; retorna false se alguma for desconhecida*/
+bool ler_opcoes(int argc, char *argv[], int inicio){
+	qtd_threads = 1;
+	for (int a = inicio; a < argc; a++){
+		if (strcmp(argv[a], "-t") == 0 && a+1 < argc)//quantidade de threads
+			qtd_threads = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-p") == 0 && a+1 < argc)//processos do modo lote
+			qtd_processos = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-r") == 0 && a+1 < argc){//semente do gerador aleatorio
+			semente = strtoull(argv[++a], NULL, 10);
+			semente_informada = true;
 		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 2){
-			pontuacao = fake_roll_up(dadoAtual, dadoPai);
+		else if (strcmp(argv[a], "-o") == 0 && a+1 < argc)//passeio completo em run-length
+			arquivo_movimentos = argv[++a];
+		else if (strcmp(argv[a], "-b") == 0 && a+1 < argc){//passeio completo com 2 bits por movimento
+			arquivo_movimentos = argv[++a];
+			movimentos_binario = true;
 		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 3){
-			pontuacao = roll_right(dadoAtual, dadoPai);
+		else if (strcmp(argv[a], "-j") == 0 && a+1 < argc)//instrumentacao em JSON
+			arquivo_instrumentacao = argv[++a];
+		else if (strcmp(argv[a], "-d") == 0 && a+1 < argc)//prazo de tempo de parede
+			prazo_segundos = atof(argv[++a]);
+		else if (strcmp(argv[a], "-c") == 0 && a+1 < argc)//cache de solucoes
+			diretorio_cache = argv[++a];
+		else if (strcmp(argv[a], "-C") == 0 && a+1 < argc){//cache de solucoes, buscando a partir do passeio salvo
+			diretorio_cache = argv[++a];
+			refinar_cache = true;
 		}
-		else if (relacaoPaiFilho(actualVertex, vertexPai) == 4){
-			pontuacao = roll_down(dadoAtual, dadoPai);
+		else if (strcmp(argv[a], "-k") == 0 && a+1 < argc)//tamanho do pool de elite
+			tamanho_elite = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-B") == 0 && a+1 < argc)//decomposicao em blocos
+			lado_decomposicao = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-m") == 0 && a+1 < argc)//memoria da tabela de transposicao, em MB
+			megabytes_transposicao = atoi(argv[++a]);
+		else if (strcmp(argv[a], "-e") == 0)//modo exato
+			modo_exato = true;
+		else if (strcmp(argv[a], "-n") == 0 && a+1 < argc)//limite de nos do modo exato
+			limite_nos = strtoull(argv[++a], NULL, 10);
+		else if (strcmp(argv[a], "-s") == 0 && a+1 < argc)//limite de tempo do modo exato
+			limite_segundos = atof(argv[++a]);
+		else {
+			printf("Opcao desconhecida: %s\n", argv[a]);
+			return false;
 		}
-		return pontuacao;
 	}
-	return 0;
+	if (qtd_threads < 1)
+		qtd_threads = 1;
+	if (qtd_processos < 1)
+		qtd_processos = 1;
+	if (tamanho_elite < 0)
+		tamanho_elite = 0;
+	if (!semente_informada)
+		semente = (uint64_t) time(NULL);
+	return true;
 }
 
-
-// 1 - esq, 2 - cima, 3 - direita, 4 - baixo
-int relacaoPaiFilho(vertex* filho, vertex* pai){
-	if((*filho).i == (*pai).i && (*filho).j == (*pai).j-1)
-		return 1;
-	if((*filho).i == (*pai).i-1 && (*filho).j == (*pai).j)
-		return 2;
-	if((*filho).i == (*pai).i && (*filho).j == (*pai).j+1)
-		return 3;
-	if((*filho).i == (*pai).i+1 && (*filho).j == (*pai).j)
-		return 4;
-	return 0;
+/*Converte um argumento inteiro nao negativo; retorna -1 se ele for invalido*/
+int ler_posicao(const char* texto){
+	char* fim;
+	long valor = strtol(texto, &fim, 10);
+	if (fim == texto || *fim != '\0' || valor < 0 || valor > INT_MAX)
+		return -1;
+	return (int) valor;
 }
 
+/**Le o mapa, valida a origem e resolve. Usado pelo main e por cada job do modo lote.
+ * config_pontuacao_max() deve ter sido chamada antes (a tabela nao depende do mapa).
+ */
+int resolver_mapa(const char* caminho, int dice_i_pos, int dice_j_pos){
+	INSTR(instr_fase_inicio(FASE_LEITURA));
+	if (!init_graph(caminho, dice_i_pos, dice_j_pos))
+		return RESOLUCAO_ERRO_LEITURA;
+	INSTR(instr_fase_fim(FASE_LEITURA));
+	if (dice_i_pos < 0 || dice_i_pos >= m_ || dice_j_pos < 0 || dice_j_pos >= n_
+			|| grade.black[grid_index(&grade, dice_i_pos, dice_j_pos)])
+		return RESOLUCAO_ORIGEM_INVALIDA;
+
+	init_data();
+	if (total_free_vertexes % 2 != 0)
+		return RESOLUCAO_IMPAR;
+
+	//cache: num acerto devolve o passeio salvo, ou (-C) o usa como primeira incumbente da busca
+	solucao_do_cache = false;
+	decomposicao_usada = false;
+	resultado_fronteira = -1;
+	int pontuacao_cache = 0;
+	if (diretorio_cache != NULL){
+		pontuacao_cache = cache_ler(diretorio_cache, &grade, dice_i_pos, dice_j_pos, melhor_solucao, total_free_vertexes);
+		pontuacao_melhor_solucao = pontuacao_cache;
+		if (pontuacao_cache > 0 && !refinar_cache){
+			solucao_do_cache = true;
+			return RESOLUCAO_OK;
+		}
+	}
 
+	INSTR(instr_fase_inicio(FASE_CONSTRUCAO));
+	//mapas estreitos: a programacao dinamica de fronteira da o passeio otimo em tempo linear no lado maior
+	if ((m_ < n_ ? m_ : n_) <= LADO_MAX_FRONTEIRA)
+		resultado_fronteira = resolver_por_fronteira(&grade, grid_index(&grade, dice_i_pos, dice_j_pos),
+				total_free_vertexes, melhor_solucao);
+	//na decomposicao os blocos sao resolvidos por processos filhos; se ela nao fechar um passeio, resolve o mapa inteiro
+	if (resultado_fronteira >= 0){
+		pontuacao_melhor_solucao = resultado_fronteira;
+		limite_superior = pontuacao_max(total_free_vertexes, DICE_INICIAL, DIRECAO_NENHUMA);
+		otimalidade_provada = true;
+	}
+	else if (lado_decomposicao > 0 && resolver_por_blocos(lado_decomposicao, qtd_processos)){
+		decomposicao_usada = true;
+		limite_superior = pontuacao_max(total_free_vertexes, DICE_INICIAL, DIRECAO_NENHUMA);
+		otimalidade_provada = pontuacao_melhor_solucao >= limite_superior;
+	}
+	else
+		solve();
+	INSTR(instr_fase_fim(FASE_CONSTRUCAO));
+
+	if (diretorio_cache != NULL && pontuacao_melhor_solucao > pontuacao_cache)
+		cache_gravar(diretorio_cache, &grade, dice_i_pos, dice_j_pos, melhor_solucao, total_free_vertexes, pontuacao_melhor_solucao);
+	return RESOLUCAO_OK;
+}
 
 int main(int argc, char *argv[]) {
 
+	if (argc >= 2 && strcmp(argv[1], "-lote") == 0){
+		//jobs "mapa linha coluna populacao" lidos da entrada padrao, um resultado por linha
+		if (!ler_opcoes(argc, argv, 2))
+			return EXIT_FAILURE;
+		config_pontuacao_max();
+		return executar_lote(qtd_processos) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	if (argc >= 2){
-		FILE *file = fopen( argv[1], "r" );
-		if ( file == 0 ){
-			printf( "Impossivel abrir arquivo, encerrando\n" );
-			return EXIT_SUCCESS;
-		}else if (argc >= 5){
+		if (argc >= 5){
+			int dice_i_pos = ler_posicao(argv[2]);
+			int dice_j_pos = ler_posicao(argv[3]);
+			populacao_solucao_inicial = atoi(argv[4]);
+			//populacao_solucao_inicial = argv[4][0] - 48;
+			if (!ler_opcoes(argc, argv, 5))
+				return EXIT_FAILURE;
+			imprimir_incumbentes = prazo_segundos > 0;
+
+			INSTR(instr_fase_inicio(FASE_LIMITES));
+			config_pontuacao_max();
+			INSTR(instr_fase_fim(FASE_LIMITES));
+
+			//tempo de parede: clock() soma o tempo de CPU de todas as threads
+			double inicio = relogio_monotonico();
+			int resultado = resolver_mapa(argv[1], dice_i_pos, dice_j_pos);
+			double decorrido = relogio_monotonico() - inicio;
+			if (resultado == RESOLUCAO_ERRO_LEITURA){
+				printf( "Impossivel abrir arquivo, encerrando\n" );
+				return EXIT_SUCCESS;
+			}
 			printf("Arquivo encontrado: ");
 			printf("%s",argv[1]);
 			printf("\n");
-			int dice_i_pos = argv[2][0] - 48;
-			int dice_j_pos = argv[3][0] - 48;
-			populacao_solucao_inicial = atoi(argv[4]);
-			//populacao_solucao_inicial = argv[4][0] - 48;
+			if (resultado == RESOLUCAO_ORIGEM_INVALIDA){
+				printf("Posicao do dado fora do mapa ou em uma casa preta.");
+				return EXIT_SUCCESS;
+			}
+			if (resultado == RESOLUCAO_IMPAR){
+				printf("O numero de casas livres eh impar. Nao existe solucao para o problema.");
+				return EXIT_SUCCESS;
+			}
 
-			init_graph(file, dice_i_pos, dice_j_pos);
+			INSTR(instr_fase_inicio(FASE_SAIDA));
+			print_solution((float) decorrido);
+			if (arquivo_movimentos != NULL && pontuacao_melhor_solucao > 0
+					&& !salvar_movimentos(arquivo_movimentos, &grade, grid_index(&grade, origin_i, origin_j),
+							melhor_solucao, total_free_vertexes, pontuacao_melhor_solucao, movimentos_binario)){
+				printf("Impossivel escrever o arquivo %s\n", arquivo_movimentos);
+			}
+			INSTR(instr_fase_fim(FASE_SAIDA));
+
+			if (arquivo_instrumentacao != NULL){
+#ifdef INSTRUMENTACAO
+				if (!instr_exportar_json(arquivo_instrumentacao, &instr_total))
+					printf("Impossivel escrever o arquivo %s\n", arquivo_instrumentacao);
+#else
+				printf("Instrumentacao indisponivel: compile com -DINSTRUMENTACAO para usar -j\n");
+#endif
+			}
 		}
 		else {
-			printf("Argumentos Insuficientes, insira: nome do arquivo, posio xy do dado e o tamanho da pop inicial");
+			printf("Argumentos Insuficientes, insira: nome do arquivo, posi��o xy do dado e o tamanho da pop inicial");
 			return EXIT_SUCCESS;
 		}
-		srand( (unsigned)time(NULL) );//preparando pra usar numeros aleatorios
-		init_data();
-		config_pontuacao_max();
-		if (total_free_vertexes % 2 != 0){
-			printf("O numero de casas livres eh impar. Nao existe solucao para o problema.");
-			return EXIT_SUCCESS;
-		}
-		clock_t t;
-		t = clock();
-		solve();
-		t = clock() - t;
-		print_solution(((float)t)/CLOCKS_PER_SEC);
 	}
 	else {
 		printf("Argumentos insuficientes\n" );
@@ -464,12 +986,32 @@ void print_solution(float time_elapsed){
 	if (pontuacao_melhor_solucao > 0){
 		int k = 0;
 		for (k = 0; k < total_free_vertexes && k < 1000; k++){
-			printf("[%d,%d] ", melhor_solucao[k]->i, melhor_solucao[k]->j);
+			printf("[%d,%d] ", grid_i(&grade, melhor_solucao[k]), grid_j(&grade, melhor_solucao[k]));
+		}
+		if (k < total_free_vertexes){
+			//o passeio completo sai como movimentos em run-length a partir da origem
+			printf("Solucao muito grande, impressao interrompida.\nMovimentos: ");
+			imprimir_movimentos(stdout, &grade, grid_index(&grade, origin_i, origin_j), melhor_solucao, total_free_vertexes);
 		}
-		if (k < total_free_vertexes)
-			printf("Solucao muito grande, impressao interrompida.");
 	}
 	printf("\nValor da melhor pontuacao: %d", pontuacao_melhor_solucao);
+	if (pontuacao_construtor_blocos > 0)
+		printf("\nPontuacao do construtor em blocos: %d", pontuacao_construtor_blocos);
+	if (solucao_do_cache)
+		printf("\nSolucao lida do cache: %s", diretorio_cache);
+	if (resultado_fronteira > 0)
+		printf("\nProgramacao dinamica de fronteira: solucao otima (%d estados na maior camada)", estados_fronteira);
+	else if (resultado_fronteira == 0)
+		printf("\nProgramacao dinamica de fronteira: o mapa nao tem passeio");
+	else if ((m_ < n_ ? m_ : n_) <= LADO_MAX_FRONTEIRA && !solucao_do_cache && estados_fronteira > 0)
+		printf("\nProgramacao dinamica de fronteira: limite de estados excedido, mapa resolvido pela busca");
+	else if ((m_ < n_ ? m_ : n_) <= LADO_MAX_FRONTEIRA && !solucao_do_cache)
+		printf("\nProgramacao dinamica de fronteira: estimativa de estados acima do limite, mapa resolvido pela busca");
+	if (decomposicao_usada)
+		printf("\nDecomposicao: %d blocos costurados (%d rodadas)", qtd_blocos_decomposicao, qtd_rodadas_decomposicao);
+	else if (lado_decomposicao > 0 && !solucao_do_cache)
+		printf("\nDecomposicao: os blocos nao fecharam um passeio, mapa resolvido inteiro");
+	printf("\nSemente: %llu", (unsigned long long) semente);
 	printf("\nNumero de branches: %llu", count_branches);
 	if (time_elapsed > 0)
 		printf("\nTempo de processamento: %.3f segundos\n", time_elapsed);
@@ -477,136 +1019,198 @@ void print_solution(float time_elapsed){
 		printf("\nTempo de processamento: 0.000 segundos\n");
 	}
 	printf("\nQuantidade de solucoes encontradas: %llu\n", qtd_solucoes_validas);
-	printf("\nQtd de retornos por melhor pontuao alcanada: %llu\n", qtd_bound_pontuacao_max);
-	printf("\nQtd de retornos por vrtice preto null ou visitado: %llu\n", qtd_bound_null_black_visited);
+	if (pontuacao_melhor_solucao > 0 && pontuacao_melhor_solucao >= limite_superior)
+		printf("\nLimite superior (%d) atingido: a solucao eh otima\n", limite_superior);
+	if (modo_exato && resultado_fronteira < 0){
+		if (otimalidade_provada)
+			printf("\nOtimalidade provada: sim (arvore de busca esgotada)\n");
+		else
+			printf("\nOtimalidade provada: nao (limite de nos ou de tempo atingido)\n");
+	}
+	printf("\nQtd de retornos por melhor pontua��o alcan�ada: %llu\n", qtd_bound_pontuacao_max);
+	printf("\nQtd de retornos por v�rtice preto null ou visitado: %llu\n", qtd_bound_null_black_visited);
 	printf("\nQtd de retornos por grau de algum vizinho == 1: %llu\n", qtd_bound_grau_vizinho_1);
+	printf("\nQtd de retornos por desconexao do grafo: %llu (buscas: %llu)\n", qtd_bound_desconexo, qtd_buscas_conexao);
+	printf("\nQtd de retornos por transposicao: %llu\n", qtd_bound_transposicao);
+	printf("\nQtd de movimentos forcados: %llu\n", qtd_movimentos_forcados);
+	printf("\nQtd de melhorias da busca local: %llu\n", qtd_melhorias_busca_local);
+	printf("\nQtd de melhorias por religacao de caminhos: %llu\n", qtd_melhorias_religacao);
+	printf("\nQtd de melhorias por simetria: %llu (automorfismos do mapa: %d)\n", qtd_melhorias_simetria, qtd_simetrias);
+	printf("\nQtd de ramos roubados: %llu\n", qtd_ramos_roubados);
 }
 
-/*esvazia a pilha e outras variveis para permitir o restart do GRASP*/
-void reset_stack(){
-	head_solucao_parcial = 0;
-	pontuacao_parcial = 0;
-	for(int i = 0; i < total_free_vertexes+1; i++){
-		solucao_parcial[i] = 0;
+/*esvazia a pilha e outras vari�veis para permitir o restart do GRASP*/
+void reset_stack(contexto* c){
+	//O backtracking ja desmarca tudo o que sai da pilha, entao os unicos vertices ainda visitados
+	//sao os da solucao parcial. Desmarcando somente eles o custo fica proporcional ao caminho,
+	//e nao ao tamanho da grade. A pilha e a solucao parcial nao precisam ser zeradas.
+	for(int i = 0; i < c->head_solucao_parcial; i++){
+		desvisitar(c, c->solucao_parcial[i]);
+		atomic_store_explicit(&c->posicao_caminho[i], INT_MAX, memory_order_relaxed);
 	}
-	for(int i = 0; i < m_*n_*4; i++){
-		stack[i] = 0;
-	}
-	head_stack = -1;
-	vertex_restantes= total_free_vertexes;
+	c->head_solucao_parcial = 0;
+	c->pontuacao_parcial = 0;
+	c->head_stack = -1;
+	c->vertex_restantes= total_free_vertexes;
 
-	for (int i = 0; i < m_; i++){
-		for (int j = 0; j < n_; j++){
-			matrix[i][j].visited = false;
-			matrix[i][j].d = new_dice(i,j);
-		}
-	}
+	//os demais dados sao sobrescritos pelo roll ao serem visitados, somente o da origem eh lido antes disso
+	c->dado[c->origin] = DICE_INICIAL;
+}
 
+/**Reaproveita o buffer p se ele ja comporta qtd elementos (capacidade alocada num job anterior),
+ * senao realoca. Assim, no modo lote os buffers ficam do tamanho do maior mapa ja resolvido.
+ */
+void* reservar(void* p, size_t tamanho_elemento, int qtd, int capacidade){
+	if (p != NULL && qtd <= capacidade)
+		return p;
+	return realloc(p, tamanho_elemento*qtd);
 }
 
-void init_data(){
-	vertex** solucao_parcial_temp = (vertex**) malloc(sizeof(vertex*)*(total_free_vertexes+1));
-	solucao_parcial = &solucao_parcial_temp[1];//Permitindo que o ndice -1 guarde o vrtice de origem
+/*Prepara o estado de busca de um worker, com os seus proprios arrays de visitados e dados.
+ *O contexto deve comecar zerado; os buffers de uma chamada anterior sao reaproveitados*/
+void init_contexto(contexto* c, uint64_t semente, uint64_t fluxo){
+	int celulas = grade.tamanho;
+	int vertices = total_free_vertexes+1;
+
+	c->visited = (bool*) reservar(c->visited, sizeof(bool), celulas, c->capacidade_grade);
+	memset(c->visited, 0, sizeof(bool)*celulas);
+	c->hash_visitadas = 0;
+	c->dado = (dice*) reservar(c->dado, sizeof(dice), celulas, c->capacidade_grade);
+	c->origin = grid_index(&grade, origin_i, origin_j);
+	c->dado[c->origin] = DICE_INICIAL;
+	c->grau_livre = (int*) reservar(c->grau_livre, sizeof(int), celulas, c->capacidade_grade);
+	for (int idx = 0; idx < celulas; idx++){
+		c->grau_livre[idx] = grade.black[idx] ? 0 : count_vizinhos_livres(c, idx, -1);
+	}
 
-	head_solucao_parcial = 0;
-	pontuacao_parcial = 0;
+	int* solucao_parcial_temp = c->solucao_parcial != NULL ? &c->solucao_parcial[-1] : NULL;
+	solucao_parcial_temp = (int*) reservar(solucao_parcial_temp, sizeof(int), vertices, c->capacidade_vertices);
+	c->solucao_parcial = &solucao_parcial_temp[1];//Permitindo que o �ndice -1 guarde o v�rtice de origem
 
-	melhor_solucao = (vertex**) malloc(sizeof(vertex*)*total_free_vertexes);
-	pontuacao_melhor_solucao = 0;
+	c->head_solucao_parcial = 0;
+	c->pontuacao_parcial = 0;
 
-	stack = (vertex**) malloc(sizeof(vertex*)*m_*n_*4);
-	head_stack = -1;
+	c->melhor_solucao = (int*) reservar(c->melhor_solucao, sizeof(int), vertices, c->capacidade_vertices);
+	c->pontuacao_melhor_solucao = 0;
+
+	c->stack = (int*) reservar(c->stack, sizeof(int)*4, celulas, c->capacidade_grade);
+	c->head_stack = -1;
+	c->posicao_caminho = (atomic_int*) reservar(c->posicao_caminho, sizeof(atomic_int), vertices, c->capacidade_vertices);
+	for (int k = 0; k < vertices; k++){
+		atomic_init(&c->posicao_caminho[k], INT_MAX);
+	}
+	if (c->capacidade_grade == 0)//primeira chamada com este contexto
+		pthread_mutex_init(&c->trava_roubo, NULL);
+
+	c->vertex_restantes = total_free_vertexes;
+
+	//Parte da verificacao de conexao
+	c->pilha_conexao = (int*) reservar(c->pilha_conexao, sizeof(int), celulas, c->capacidade_grade);
+	c->marca = (unsigned int*) reservar(c->marca, sizeof(unsigned int), celulas, c->capacidade_grade);
+	memset(c->marca, 0, sizeof(unsigned int)*celulas);
+	c->geracao_marca = 0;
+
+	init_busca_local(c);
+	c->solucao_simetrica = (int*) reservar(c->solucao_simetrica, sizeof(int), vertices, c->capacidade_vertices);
+	c->imagem_simetrica = (int*) reservar(c->imagem_simetrica, sizeof(int), vertices, c->capacidade_vertices);
+	INSTR(instr_init(&c->instr, total_free_vertexes));
+
+	if (celulas > c->capacidade_grade)
+		c->capacidade_grade = celulas;
+	if (vertices > c->capacidade_vertices)
+		c->capacidade_vertices = vertices;
+
+	pcg32_iniciar(&c->gerador, semente, fluxo);
+
+	c->count_branches = 0;
+	c->qtd_solucoes_validas = 0;
+	c->qtd_bound_pontuacao_max = 0;
+	c->qtd_bound_null_black_visited = 0;
+	c->qtd_bound_grau_vizinho_1 = 0;
+	c->qtd_movimentos_forcados = 0;
+	c->qtd_bound_desconexo = 0;
+	c->qtd_bound_transposicao = 0;
+	c->qtd_buscas_conexao = 0;
+	c->qtd_melhorias_religacao = 0;
+	c->qtd_melhorias_simetria = 0;
+	c->qtd_ramos_roubados = 0;
+}
 
-	vertex_restantes = total_free_vertexes;
+/*Soma os contadores dos workers e escolhe a melhor solucao entre eles*/
+void merge_contextos(contexto* contextos, int qtd_contextos){
+	for (int t = 0; t < qtd_contextos; t++){
+		contexto* c = &contextos[t];
+		count_branches += c->count_branches;
+		qtd_solucoes_validas += c->qtd_solucoes_validas;
+		qtd_bound_pontuacao_max += c->qtd_bound_pontuacao_max;
+		qtd_bound_null_black_visited += c->qtd_bound_null_black_visited;
+		qtd_bound_grau_vizinho_1 += c->qtd_bound_grau_vizinho_1;
+		qtd_movimentos_forcados += c->qtd_movimentos_forcados;
+		qtd_bound_desconexo += c->qtd_bound_desconexo;
+		qtd_bound_transposicao += c->qtd_bound_transposicao;
+		qtd_buscas_conexao += c->qtd_buscas_conexao;
+		qtd_melhorias_busca_local += c->qtd_melhorias_busca_local;
+		qtd_melhorias_religacao += c->qtd_melhorias_religacao;
+		qtd_melhorias_simetria += c->qtd_melhorias_simetria;
+		qtd_ramos_roubados += c->qtd_ramos_roubados;
+		INSTR(instr_merge(&instr_total, &c->instr));
+		if (c->pontuacao_melhor_solucao > pontuacao_melhor_solucao){
+			for (int i = 0; i < total_free_vertexes; i++){
+				melhor_solucao[i] = c->melhor_solucao[i];
+			}
+			pontuacao_melhor_solucao = c->pontuacao_melhor_solucao;
+		}
+	}
+}
 
-	//Parte da busca em profundidade
-	vertex_visitados_profundidade = (vertex**) malloc(sizeof(vertex*)*total_free_vertexes);
-	vertex_atingidos = 0;
+void init_data(){
+	static int capacidade_melhor_solucao = 0;
+	melhor_solucao = (int*) reservar(melhor_solucao, sizeof(int), total_free_vertexes, capacidade_melhor_solucao);
+	if (total_free_vertexes > capacidade_melhor_solucao)
+		capacidade_melhor_solucao = total_free_vertexes;
+	pontuacao_melhor_solucao = 0;
+	pontuacao_construtor_blocos = 0;
+	detectar_simetrias(&grade);
 
 	count_branches = 0;
 	qtd_solucoes_validas = 0;
 	qtd_bound_pontuacao_max = 0;
 	qtd_bound_null_black_visited = 0;
 	qtd_bound_grau_vizinho_1 = 0;
+	qtd_movimentos_forcados = 0;
+	qtd_bound_desconexo = 0;
+	qtd_bound_transposicao = 0;
+	qtd_buscas_conexao = 0;
+	qtd_melhorias_busca_local = 0;
+	qtd_melhorias_religacao = 0;
+	qtd_melhorias_simetria = 0;
+	qtd_ramos_roubados = 0;
+
+	INSTR(instr_init(&instr_total, total_free_vertexes));
 
 	//Parte do GRASP
-	solucoes_iniciais = (vertex***) malloc(sizeof(vertex**)*populacao_solucao_inicial);
-}
-
-/** Configura o array de pontuacao maxima para N jogadas*/
-void config_pontuacao_max(){
-	int qtd_jogadas_alocar = total_free_vertexes+1;
-	if (qtd_jogadas_alocar < 22)
-		qtd_jogadas_alocar = 22;
-	pontuacao_max_para_cada_numero_jogadas = malloc((sizeof(int)*qtd_jogadas_alocar));
-
-	pontuacao_max_para_cada_numero_jogadas[0] = 0;
-	pontuacao_max_para_cada_numero_jogadas[1] = 6;
-	pontuacao_max_para_cada_numero_jogadas[2] = 11;
-	pontuacao_max_para_cada_numero_jogadas[3] = 15;
-	pontuacao_max_para_cada_numero_jogadas[4] = 21;
-	pontuacao_max_para_cada_numero_jogadas[5] = 24;
-	pontuacao_max_para_cada_numero_jogadas[6] = 29;
-	pontuacao_max_para_cada_numero_jogadas[7] = 33;
-	pontuacao_max_para_cada_numero_jogadas[8] = 39;
-	pontuacao_max_para_cada_numero_jogadas[9] = 49;
-	pontuacao_max_para_cada_numero_jogadas[10] = 47;
-	pontuacao_max_para_cada_numero_jogadas[11] = 51;
-	pontuacao_max_para_cada_numero_jogadas[12] = 56;
-	pontuacao_max_para_cada_numero_jogadas[13] = 59;
-	pontuacao_max_para_cada_numero_jogadas[14] = 65;
-	pontuacao_max_para_cada_numero_jogadas[15] = 68;
-	pontuacao_max_para_cada_numero_jogadas[16] = 74;
-	pontuacao_max_para_cada_numero_jogadas[17] = 77;
-	pontuacao_max_para_cada_numero_jogadas[18] = 83;
-	pontuacao_max_para_cada_numero_jogadas[19] = 86;
-	pontuacao_max_para_cada_numero_jogadas[20] = 91;
-	pontuacao_max_para_cada_numero_jogadas[21] = 95;
-	pontuacao_max_para_cada_numero_jogadas[22] = 100;
-
-	if (total_free_vertexes >= 23){
-		for (int vertex_restantes = 23; vertex_restantes <= total_free_vertexes; vertex_restantes++){
-			int pontuacao_max = 0;
-
-			if (vertex_restantes%3 == 0)//se  um multiplo exato (trata n == 0)
-				pontuacao_max = (vertex_restantes/3 * 6) + (vertex_restantes/3 * 5) + (vertex_restantes/3 * 4);
-			else if (vertex_restantes%3 == 1)
-				pontuacao_max = (vertex_restantes/3 * 6) + (vertex_restantes/3 * 5) + (vertex_restantes/3 * 4) + 6;
-			else if (vertex_restantes%3 == 2)
-				pontuacao_max = (vertex_restantes/3 * 6) + (vertex_restantes/3 * 5) + (vertex_restantes/3 * 4) + 6 + 5;
-
-			pontuacao_max_para_cada_numero_jogadas[vertex_restantes] = pontuacao_max;
-		}
+	static int* buffer_elite = NULL;
+	static int capacidade_elite = 0;
+	buffer_elite = (int*) reservar(buffer_elite, sizeof(int), tamanho_elite*total_free_vertexes, capacidade_elite);
+	if (tamanho_elite*total_free_vertexes > capacidade_elite)
+		capacidade_elite = tamanho_elite*total_free_vertexes;
+	solucoes_iniciais = (int**) realloc(solucoes_iniciais, sizeof(int*)*(tamanho_elite+1));
+	pontuacao_elite = (int*) realloc(pontuacao_elite, sizeof(int)*(tamanho_elite+1));
+	for (int k = 0; k < tamanho_elite; k++){
+		solucoes_iniciais[k] = &buffer_elite[k*total_free_vertexes];
 	}
+	qtd_elite = 0;
 }
 
-
-void init_graph(FILE *fp, int dice_i_pos, int dice_j_pos){
-	char x;//char lixo
-
-	fscanf (fp, "%d%c", &m_, &x);
-	fscanf (fp, "%d%c", &n_, &x);
-	int vertex_value = 0;
-
-	matrix = (vertex**) calloc(m_, sizeof(vertex*));
-	for (int j = 0; j < m_; j++){
-		matrix[j] = (vertex*) calloc(n_, sizeof(vertex));
-	}
-
-	for (int i = 0; i < m_; i++){
-		for (int j = 0; j < n_; j++){
-			fscanf (fp, "%d%c", &vertex_value, &x);
-			matrix[i][j].i = i;
-			matrix[i][j].j = j;
-			matrix[i][j].black = vertex_value == 0;
-			matrix[i][j].visited = false;
-			matrix[i][j].d = new_dice(i,j);
-			if (!matrix[i][j].black)
-				total_free_vertexes++;
-		}
-	}
-	fclose(fp);
-	origin = &matrix[dice_i_pos][dice_j_pos];
+/*Le o mapa (texto ou binario) para a grade. Retorna false se o arquivo nao puder ser lido*/
+bool init_graph(const char* caminho, int dice_i_pos, int dice_j_pos){
+	if (!carregar_mapa(caminho, &grade, &total_free_vertexes))
+		return false;
+	m_ = grade.m;
+	n_ = grade.n;
+	origin_i = dice_i_pos;
+	origin_j = dice_j_pos;
+	return true;
 }
 
 
@@ -9,19 +9,144 @@
 #define HIKERDICE_BRANCHANDBOUND_H_
 
 #include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include "graph.h"
+#include "random.h"
+#include "instrumentation.h"
+
+//retornos de vizinho_forcado() quando nao ha um unico movimento forcado
+#define SEM_FORCADO -1
+#define BECO_SEM_SAIDA -2
+
+//retornos de resolver_mapa()
+#define RESOLUCAO_OK 0
+#define RESOLUCAO_ERRO_LEITURA 1
+#define RESOLUCAO_ORIGEM_INVALIDA 2
+#define RESOLUCAO_IMPAR 3
+
+/**Estado de busca de um worker do GRASP.
+ * Cada thread possui o seu proprio contexto (visitados, dados, pilha, solucao parcial e contadores),
+ * de forma que somente a pontuacao incumbente e o contador de restarts sao compartilhados.
+ */
+typedef struct cb{
+	bool* visited;//por celula da grade (indice de grid_index)
+	dice* dado;//orientacao do dado em cada celula
+	int origin;//indice do vertice de saida
+	int* grau_livre;//vizinhos livres (nao pretos e nao visitados, ou a origem) de cada celula
+	uint64_t hash_visitadas;//Zobrist das celulas visitadas (tabela de transposicao)
+
+	//pilha, solucoes e caminhos guardam indices da grade
+	int* stack;//pilha de busca do branch and bound
+	int head_stack;//cabeca da pilha de busca
+	atomic_int* posicao_caminho;//posicao na pilha de cada vertice da solucao parcial (INT_MAX alem dela)
+
+	//parte do roubo de trabalho do modo exato (work_stealing.h): a pilha eh o deque do contexto
+	atomic_int topo_roubo;//head_stack publicado para os ladroes
+	atomic_int base_roubo;//abaixo dela so ha entradas roubadas e o caminho ate elas (de onde os ladroes procuram)
+	atomic_int limite_proprio;//acima do ramo roubado mais alto: abaixo dele, o caminho tem parte da subarvore com um ladrao
+	pthread_mutex_t trava_roubo;
+
+	int* solucao_parcial;//sequencia de vertices da solucao sendo construida
+	int head_solucao_parcial;//cabeca da solucao parcial
+	int pontuacao_parcial;//pontuacao parcial sendo construida
+	int vertex_restantes;
+
+	int* melhor_solucao;//melhor solucao encontrada por este contexto
+	int pontuacao_melhor_solucao;//pontuacao da melhor solucao deste contexto (0 se nenhuma)
+
+	//parte da verificacao de conexao do grafo
+	int* pilha_conexao;
+	unsigned int* marca;//rotulo (geracao_marca + alvo) das celulas alcancadas na busca atual
+	unsigned int geracao_marca;
+
+	//parte da busca local: passeio com origem nas duas pontas, dado e pontuacao acumulada em cada posicao
+	int* caminho;
+	dice* dados_caminho;
+	int* pontuacao_prefixo;
+	int* pos_caminho;//posicao de cada celula no caminho
+
+	//parte da religacao de caminhos com o pool de elite
+	uint8_t* arestas_guia;//por celula, bit d marca a aresta para o vizinho na direcao d no passeio guia
+	int* parceiro_elite;//copia da solucao sorteada do pool
+	int* solucao_religada;//melhor intermediario da religacao
+
+	//parte das imagens do passeio pelos automorfismos do mapa
+	int* solucao_simetrica;//melhor imagem
+	int* imagem_simetrica;//imagem sendo avaliada
+
+	//tamanho alocado dos buffers por celula e por vertice (reaproveitados entre os jobs do modo lote)
+	int capacidade_grade;
+	int capacidade_vertices;
+
+	pcg32 gerador;//gerador aleatorio deste contexto (semente global, fluxo proprio)
+
+	unsigned long long count_branches;
+	unsigned long long qtd_solucoes_validas;
+	unsigned long long qtd_bound_pontuacao_max;
+	unsigned long long qtd_bound_null_black_visited;
+	unsigned long long qtd_bound_grau_vizinho_1;
+	unsigned long long qtd_movimentos_forcados;
+	unsigned long long qtd_bound_desconexo;
+	unsigned long long qtd_bound_transposicao;
+	unsigned long long qtd_buscas_conexao;
+	unsigned long long qtd_melhorias_busca_local;
+	unsigned long long qtd_melhorias_religacao;
+	unsigned long long qtd_melhorias_simetria;
+	unsigned long long qtd_ramos_roubados;
+
+	INSTR(instrumentacao instr;)
+} contexto;
+
+extern grid grade;
+extern int m_, n_;
+extern int total_free_vertexes;
+extern int origin_i, origin_j;
+extern int* melhor_solucao;
+extern int pontuacao_melhor_solucao;
+extern int populacao_solucao_inicial;
+extern unsigned long long count_branches;
+extern unsigned long long qtd_solucoes_validas;
+extern bool imprimir_incumbentes;
+extern double prazo_segundos;
+extern bool solucao_do_cache;
+extern uint64_t semente;
+extern unsigned long long qtd_melhorias_busca_local;
+extern int pontuacao_construtor_blocos;
 
 void print_solution(float time_elapsed);
+int resolver_mapa(const char* caminho, int dice_i_pos, int dice_j_pos);
+bool ler_opcoes(int argc, char *argv[], int inicio);
+int ler_posicao(const char* texto);
+void solve();
+void* reservar(void* p, size_t tamanho_elemento, int qtd, int capacidade);
 void init_data();
-void config_pontuacao_max();
-void init_graph(FILE *fp, int dice_i_pos, int dice_j_pos);
-void add_childs(vertex* atual, vertex** stack);
+void init_contexto(contexto* c, uint64_t semente, uint64_t fluxo);
+void merge_contextos(contexto* contextos, int qtd_contextos);
+bool init_graph(const char* caminho, int dice_i_pos, int dice_j_pos);
+void add_childs(contexto* c, int atual);
 void avaliar_melhor_solucao();
-void roll_dice(vertex* actualVertex, vertex *vertexPai);
-int fake_roll_dice(vertex* actualVertex, vertex *vertexPai);
-int relacaoPaiFilho(vertex* filho, vertex* pai);
-void generate_greedy_solutions();
-void reset_stack();
+void roll_dice(contexto* c, int actualVertex, int vertexPai);
+int fake_roll_dice(contexto* c, int actualVertex, int vertexPai);
+void generate_greedy_solutions(contexto* c);
+bool busca_em_profundidade(contexto* c, bool exata);
+bool explorar_pilha(contexto* c, bool exata);
+bool branch_and_bound(contexto* contextos, int qtd_contextos);
+void* worker_exato(void* arg);
+bool limite_busca_exata_atingido(unsigned long long nos);
+bool proximo_restart();
+bool busca_deve_parar();
+void* worker_grasp(void* arg);
+void publicar_incumbente(int pontuacao);
+void inserir_elite(const int* solucao, int pontuacao);
+void religar_com_elite(contexto* c);
+void avaliar_simetrias(contexto* c);
+void reset_stack(contexto* c);
+void visitar(contexto* c, int vtx);
+void desvisitar(contexto* c, int vtx);
+int vizinho_forcado(contexto* c, int atual);
+bool grafo_conectado(contexto* c, int next);
+bool busca_largura_conexao(contexto* c, int next, int* alvos, int qtd_alvos);
 
 
 
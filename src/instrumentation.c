@@ -0,0 +1,103 @@
+/*
+ * instrumentation.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include "instrumentation.h"
+
+#ifdef INSTRUMENTACAO
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* nome_fase[QTD_FASES] = {"leitura", "limites", "construcao", "saida"};
+static const char* nome_poda[QTD_PODAS] = {"preto_visitado", "pontuacao", "grau", "desconexo", "transposicao"};
+
+static double inicio_fase[QTD_FASES];
+static double duracao_fase[QTD_FASES];
+
+static int faixa_log2(unsigned long long valor){
+	int faixa = 0;
+	while (valor > 0 && faixa < FAIXAS_LOG2-1){
+		valor >>= 1;
+		faixa++;
+	}
+	return faixa;
+}
+
+void instr_init(instrumentacao* ins, int total_vertices){
+	free(ins->hist_profundidade);
+	free(ins->podas_por_profundidade);
+	*ins = (instrumentacao) {0};
+	ins->qtd_profundidades = total_vertices+1;
+	ins->hist_profundidade = (unsigned long long*) calloc(ins->qtd_profundidades, sizeof(unsigned long long));
+	ins->podas_por_profundidade = (unsigned long long*) calloc((size_t) QTD_PODAS*ins->qtd_profundidades, sizeof(unsigned long long));
+}
+
+void instr_merge(instrumentacao* destino, instrumentacao* origem){
+	destino->restarts += origem->restarts;
+	destino->restarts_sem_passeio += origem->restarts_sem_passeio;
+	for (int p = 0; p < destino->qtd_profundidades; p++)
+		destino->hist_profundidade[p] += origem->hist_profundidade[p];
+	for (int k = 0; k < QTD_PODAS*destino->qtd_profundidades; k++)
+		destino->podas_por_profundidade[k] += origem->podas_por_profundidade[k];
+	for (int f = 0; f < FAIXAS_LOG2; f++){
+		destino->hist_backtracks[f] += origem->hist_backtracks[f];
+		destino->hist_primeiro_passeio[f] += origem->hist_primeiro_passeio[f];
+	}
+}
+
+void instr_fase_inicio(int fase){
+	inicio_fase[fase] = relogio_monotonico();
+}
+
+void instr_fase_fim(int fase){
+	duracao_fase[fase] += relogio_monotonico() - inicio_fase[fase];
+}
+
+void instr_fim_restart(instrumentacao* ins){
+	ins->restarts++;
+	if (!ins->achou_passeio)
+		ins->restarts_sem_passeio++;
+	ins->hist_profundidade[ins->profundidade_max]++;
+	ins->hist_backtracks[faixa_log2(ins->backtracks)]++;
+}
+
+/*Imprime um histograma como lista, cortando os zeros do fim*/
+static void escrever_lista(FILE* fp, const unsigned long long* valores, int qtd){
+	while (qtd > 0 && valores[qtd-1] == 0)
+		qtd--;
+	fputc('[', fp);
+	for (int k = 0; k < qtd; k++)
+		fprintf(fp, k ? ",%llu" : "%llu", valores[k]);
+	fputc(']', fp);
+}
+
+bool instr_exportar_json(const char* caminho, instrumentacao* ins){
+	FILE* fp = fopen(caminho, "w");
+	if (fp == NULL)
+		return false;
+
+	fprintf(fp, "{\n \"fases_segundos\": {");
+	for (int f = 0; f < QTD_FASES; f++)
+		fprintf(fp, "%s\"%s\": %.6f", f ? ", " : "", nome_fase[f], duracao_fase[f]);
+	fprintf(fp, "},\n \"restarts\": %llu,\n \"restarts_sem_passeio\": %llu,\n", ins->restarts, ins->restarts_sem_passeio);
+	fprintf(fp, " \"hist_profundidade_max\": ");
+	escrever_lista(fp, ins->hist_profundidade, ins->qtd_profundidades);
+	fprintf(fp, ",\n \"hist_backtracks_log2\": ");
+	escrever_lista(fp, ins->hist_backtracks, FAIXAS_LOG2);
+	fprintf(fp, ",\n \"hist_primeiro_passeio_us_log2\": ");
+	escrever_lista(fp, ins->hist_primeiro_passeio, FAIXAS_LOG2);
+	fprintf(fp, ",\n \"podas_por_profundidade\": {");
+	for (int p = 0; p < QTD_PODAS; p++){
+		fprintf(fp, "%s\n  \"%s\": ", p ? "," : "", nome_poda[p]);
+		escrever_lista(fp, &ins->podas_por_profundidade[p*ins->qtd_profundidades], ins->qtd_profundidades);
+	}
+	fprintf(fp, "\n }\n}\n");
+
+	return fclose(fp) == 0;
+}
+
+#endif
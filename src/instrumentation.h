@@ -0,0 +1,100 @@
+/*
+ * instrumentation.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef INSTRUMENTATION_H_
+#define INSTRUMENTATION_H_
+
+#include <stdbool.h>
+#include <time.h>
+
+/*Relogio de parede monotonico, em segundos (clock() mede CPU e soma as threads)*/
+static inline double relogio_monotonico(void){
+	struct timespec agora;
+	clock_gettime(CLOCK_MONOTONIC, &agora);
+	return agora.tv_sec + agora.tv_nsec / 1e9;
+}
+
+/**Instrumentacao da busca, compilada somente com -DINSTRUMENTACAO.
+ * Sem a flag, INSTR(...) some e nenhum contador extra existe no caminho quente.
+ */
+#ifdef INSTRUMENTACAO
+#define INSTR(codigo) codigo
+#else
+#define INSTR(codigo)
+#endif
+
+//fases cronometradas de uma execucao
+#define FASE_LEITURA 0
+#define FASE_LIMITES 1
+#define FASE_CONSTRUCAO 2
+#define FASE_SAIDA 3
+#define QTD_FASES 4
+
+//podas de insert_conditions(), na ordem em que sao testadas
+#define PODA_PRETO_VISITADO 0
+#define PODA_PONTUACAO 1
+#define PODA_GRAU 2
+#define PODA_DESCONEXO 3
+#define PODA_TRANSPOSICAO 4//estado ja esgotado com pontuacao maior ou igual (testada ao entrar no vertice)
+#define QTD_PODAS 5
+
+//histogramas em escala log2: a faixa k conta valores em [2^(k-1), 2^k), e a faixa 0 conta o zero
+#define FAIXAS_LOG2 48
+
+/**Estatisticas de um contexto (deve comecar zerado; instr_init reinicia a cada job). As do restart atual sao acumuladas nos histogramas ao fim de cada restart*/
+typedef struct ins{
+	int profundidade_max;//do restart atual
+	unsigned long long backtracks;//do restart atual
+	double inicio_restart;
+	bool achou_passeio;//se o restart atual ja encontrou um passeio
+
+	int qtd_profundidades;//total_free_vertexes+1
+	unsigned long long restarts;
+	unsigned long long restarts_sem_passeio;
+	unsigned long long* hist_profundidade;//restarts por profundidade maxima alcancada
+	unsigned long long hist_backtracks[FAIXAS_LOG2];
+	unsigned long long hist_primeiro_passeio[FAIXAS_LOG2];//em microssegundos
+	unsigned long long* podas_por_profundidade;//[poda*qtd_profundidades + profundidade]
+} instrumentacao;
+
+#ifdef INSTRUMENTACAO
+void instr_init(instrumentacao* ins, int total_vertices);
+void instr_merge(instrumentacao* destino, instrumentacao* origem);
+void instr_fase_inicio(int fase);
+void instr_fase_fim(int fase);
+void instr_fim_restart(instrumentacao* ins);
+bool instr_exportar_json(const char* caminho, instrumentacao* ins);
+
+static inline void instr_inicio_restart(instrumentacao* ins){
+	ins->profundidade_max = 0;
+	ins->backtracks = 0;
+	ins->achou_passeio = false;
+	ins->inicio_restart = relogio_monotonico();
+}
+
+static inline void instr_expansao(instrumentacao* ins, int profundidade){
+	if (profundidade > ins->profundidade_max)
+		ins->profundidade_max = profundidade;
+}
+
+static inline void instr_passeio(instrumentacao* ins){
+	if (!ins->achou_passeio){
+		ins->achou_passeio = true;
+		double microssegundos = (relogio_monotonico() - ins->inicio_restart) * 1e6;
+		int faixa = 0;
+		while (faixa < FAIXAS_LOG2-1 && microssegundos >= (double) (1ULL << faixa))
+			faixa++;
+		ins->hist_primeiro_passeio[faixa]++;
+	}
+}
+
+static inline void instr_poda(instrumentacao* ins, int poda, int profundidade){
+	ins->podas_por_profundidade[poda*ins->qtd_profundidades + profundidade]++;
+}
+#endif
+
+#endif /* INSTRUMENTATION_H_ */
@@ -0,0 +1,243 @@
+/*
+ * local_search.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "local_search.h"
+
+/**Fase de busca local do GRASP.
+ *
+ * O passeio construido eh um ciclo que sai e volta para a origem:
+ * caminho[0] = origem, caminho[1..N] = solucao, e caminho[N] = origem.
+ * O movimento usado eh a inversao de segmento (2-opt): caminho[a..b] pode ser invertido
+ * sempre que caminho[a-1] for vizinho de caminho[b] e caminho[a] for vizinho de caminho[b+1].
+ * Como o ciclo eh fechado na origem, o backbite (que move a ponta livre de um caminho) se reduz
+ * a esse mesmo movimento.
+ *
+ * Para cada posicao k sao guardados o dado apos chegar em caminho[k] e a pontuacao acumulada,
+ * assim a avaliacao de uma inversao so rola o dado a partir de 'a', e para assim que a orientacao
+ * volta a coincidir com a antiga (dali em diante o sufixo nao muda).
+ */
+
+/*Rola 'pai' na direcao de 'filho', guardando o resultado em d. Retorna a face de baixo*/
+static int rolar(dice* d, dice pai, int filho, int vertexPai){
+	return roll(d, pai, grid_direcao(&grade, filho, vertexPai));
+}
+
+/*Recalcula os dados e as pontuacoes acumuladas de caminho[inicio..N]*/
+static void repontuar_sufixo(contexto* c, int inicio){
+	for (int k = inicio; k <= total_free_vertexes; k++){
+		c->pontuacao_prefixo[k] = c->pontuacao_prefixo[k-1]
+				+ rolar(&c->dados_caminho[k], c->dados_caminho[k-1], c->caminho[k], c->caminho[k-1]);
+	}
+}
+
+/*Pontuacao total do passeio caso caminho[a..b] seja invertido, sem alterar o caminho*/
+static int avaliar_inversao(contexto* c, int a, int b){
+	int N = total_free_vertexes;
+	dice d = c->dados_caminho[a-1];
+	int anterior = c->caminho[a-1];
+	int pontuacao = c->pontuacao_prefixo[a-1];
+
+	for (int k = a; k <= N; k++){
+		int v = (k <= b) ? c->caminho[a+b-k] : c->caminho[k];
+		pontuacao += rolar(&d, d, v, anterior);
+		anterior = v;
+		if (k > b && d == c->dados_caminho[k])
+			return pontuacao + c->pontuacao_prefixo[N] - c->pontuacao_prefixo[k];
+	}
+	return pontuacao;
+}
+
+static void inverter(contexto* c, int a, int b){
+	for (int i = a, j = b; i < j; i++, j--){
+		int tmp = c->caminho[i];
+		c->caminho[i] = c->caminho[j];
+		c->caminho[j] = tmp;
+	}
+	for (int k = a; k <= b; k++){
+		c->pos_caminho[c->caminho[k]] = k;
+	}
+	repontuar_sufixo(c, a);
+}
+
+/*Aloca os buffers da busca local do contexto (ou reaproveita os do job anterior)*/
+void init_busca_local(contexto* c){
+	int vertices = total_free_vertexes+1;
+	c->arestas_guia = (uint8_t*) reservar(c->arestas_guia, sizeof(uint8_t), grade.tamanho, c->capacidade_grade);
+	c->parceiro_elite = (int*) reservar(c->parceiro_elite, sizeof(int), vertices, c->capacidade_vertices);
+	c->solucao_religada = (int*) reservar(c->solucao_religada, sizeof(int), vertices, c->capacidade_vertices);
+	c->caminho = (int*) reservar(c->caminho, sizeof(int), vertices, c->capacidade_vertices);
+	c->dados_caminho = (dice*) reservar(c->dados_caminho, sizeof(dice), vertices, c->capacidade_vertices);
+	c->pontuacao_prefixo = (int*) reservar(c->pontuacao_prefixo, sizeof(int), vertices, c->capacidade_vertices);
+	c->pos_caminho = (int*) reservar(c->pos_caminho, sizeof(int), grade.tamanho, c->capacidade_grade);
+	c->qtd_melhorias_busca_local = 0;
+}
+
+/*Copia a solucao para o caminho fechado na origem e calcula dados e pontuacoes acumuladas*/
+static void carregar_caminho(contexto* c, const int* solucao){
+	c->caminho[0] = c->origin;
+	c->dados_caminho[0] = DICE_INICIAL;
+	c->pontuacao_prefixo[0] = 0;
+	for (int k = 1; k <= total_free_vertexes; k++){
+		c->caminho[k] = solucao[k-1];
+		c->pos_caminho[c->caminho[k]] = k;
+	}
+	repontuar_sufixo(c, 1);
+}
+
+/**Aplica inversoes de segmento com primeira melhoria ate atingir um otimo local.
+ * 'solucao' (total_free_vertexes vertices, terminando na origem) eh alterada no lugar,
+ * e a nova pontuacao eh retornada.
+ */
+int busca_local(contexto* c, int* solucao){
+	int N = total_free_vertexes;
+	carregar_caminho(c, solucao);
+
+	bool melhorou = true;
+	while (melhorou){
+		melhorou = false;
+		for (int a = 1; a < N-1; a++){
+			//candidatos a 'b' sao as posicoes dos vizinhos de caminho[a-1] que aparecem depois de 'a'
+			int anterior = c->caminho[a-1];
+			for (int d = 0; d < 4; d++){
+				int vizinho = anterior + grade.deslocamento[d];
+				if (grade.black[vizinho] || vizinho == c->origin)
+					continue;
+				int b = c->pos_caminho[vizinho];
+				if (b <= a || b >= N || grid_direcao(&grade, c->caminho[a], c->caminho[b+1]) < 0)
+					continue;
+				if (avaliar_inversao(c, a, b) > c->pontuacao_prefixo[N]){
+					inverter(c, a, b);
+					c->qtd_melhorias_busca_local++;
+					melhorou = true;
+					break;
+				}
+			}
+		}
+	}
+
+	for (int k = 1; k <= N; k++){
+		solucao[k-1] = c->caminho[k];
+	}
+	return c->pontuacao_prefixo[N];
+}
+
+/*Se a aresta u-v (celulas vizinhas) pertence ao passeio guia*/
+static bool aresta_guia(contexto* c, int u, int v){
+	return (c->arestas_guia[u] >> grid_direcao(&grade, v, u)) & 1;
+}
+
+/*Backbite na ponta livre do caminho aberto caminho[0..N-1]: liga caminho[N-1] a caminho[i] e inverte
+ *caminho[i+1..N-1]. Os dados e pontuacoes sao refeitos ate N-1, e ate N se a nova ponta for vizinha da origem*/
+static void backbite(contexto* c, int i){
+	int N = total_free_vertexes;
+	for (int a = i+1, b = N-1; a < b; a++, b--){
+		int tmp = c->caminho[a];
+		c->caminho[a] = c->caminho[b];
+		c->caminho[b] = tmp;
+	}
+	for (int k = i+1; k < N; k++){
+		c->pos_caminho[c->caminho[k]] = k;
+		c->pontuacao_prefixo[k] = c->pontuacao_prefixo[k-1]
+				+ rolar(&c->dados_caminho[k], c->dados_caminho[k-1], c->caminho[k], c->caminho[k-1]);
+	}
+	if (grid_direcao(&grade, c->origin, c->caminho[N-1]) >= 0)
+		repontuar_sufixo(c, N);
+}
+
+/*Pontuacao do passeio fechado resultante do backbite em i (a nova ponta caminho[i+1] deve ser vizinha da origem)*/
+static int avaliar_backbite(contexto* c, int i){
+	int N = total_free_vertexes;
+	dice d = c->dados_caminho[i];
+	int anterior = c->caminho[i];
+	int pontuacao = c->pontuacao_prefixo[i];
+	for (int k = i+1; k < N; k++){
+		int v = c->caminho[i+N-k];
+		pontuacao += rolar(&d, d, v, anterior);
+		anterior = v;
+	}
+	return pontuacao + rolar(&d, d, c->origin, anterior);
+}
+
+/**Religacao de caminhos: parte de 'inicio' e caminha em direcao a 'guia'.
+ * O passeio eh tratado como um caminho hamiltoniano aberto a partir da origem (sem a aresta de volta),
+ * e cada passo eh um backbite na ponta livre. A distancia eh a quantidade de arestas do caminho fora do guia:
+ * entre os backbites possiveis, escolhe o que mais diminui a distancia (trocar uma aresta de fora por uma do guia),
+ * depois o que fecha o passeio de maior pontuacao, e no empate sorteia. Movimentos neutros sao aceitos,
+ * exceto o que desfaz o anterior, para a ponta nao ficar presa, ate um limite de passos.
+ * Os caminhos cuja ponta eh vizinha da origem fecham um passeio valido, pontuado incrementalmente
+ * a partir do ponto do backbite. O melhor passeio intermediario vai para 'melhor' e sua pontuacao
+ * eh retornada (0 se nao houver).
+ */
+int religar_caminhos(contexto* c, const int* inicio, const int* guia, int* melhor){
+	int N = total_free_vertexes;
+	for (int k = 0; k < N; k++){
+		c->arestas_guia[guia[k]] = 0;
+	}
+	int anterior = c->origin;
+	for (int k = 0; k < N; k++){
+		c->arestas_guia[anterior] |= 1u << grid_direcao(&grade, guia[k], anterior);
+		c->arestas_guia[guia[k]] |= 1u << grid_direcao(&grade, anterior, guia[k]);
+		anterior = guia[k];
+	}
+
+	carregar_caminho(c, inicio);
+	int distancia = 0;
+	for (int k = 1; k < N; k++){
+		distancia += !aresta_guia(c, c->caminho[k-1], c->caminho[k]);
+	}
+
+	int pontuacao_melhor = 0;
+	int removida_u = -1, removida_v = -1;//aresta retirada no ultimo passo, que nao pode voltar logo em seguida
+	for (int passo = 0; passo < 2*N && distancia > 0; passo++){
+		int ponta = c->caminho[N-1];
+		int escolhido = -1, variacao_escolhido = 2, pontuacao_escolhido = -1;
+		uint32_t empates = 0;
+		for (int d = 0; d < 4; d++){
+			int v = ponta + grade.deslocamento[d];
+			if (grade.black[v] || (v == removida_u && ponta == removida_v) || (v == removida_v && ponta == removida_u))
+				continue;
+			int i = v == c->origin ? 0 : c->pos_caminho[v];
+			if (i >= N-2)
+				continue;
+			int variacao = !aresta_guia(c, ponta, v) - !aresta_guia(c, v, c->caminho[i+1]);
+			if (variacao > 0)
+				continue;
+			int pontuacao = 0;//caminho continua aberto
+			if (grid_direcao(&grade, c->origin, c->caminho[i+1]) >= 0)
+				pontuacao = avaliar_backbite(c, i);
+
+			bool melhor_movimento = variacao < variacao_escolhido
+					|| (variacao == variacao_escolhido && pontuacao > pontuacao_escolhido);
+			if (variacao == variacao_escolhido && pontuacao == pontuacao_escolhido)
+				melhor_movimento = pcg32_limitado(&c->gerador, ++empates + 1) == 0;//sorteio uniforme entre os empatados
+			else if (melhor_movimento)
+				empates = 0;
+			if (melhor_movimento){
+				escolhido = i;
+				variacao_escolhido = variacao;
+				pontuacao_escolhido = pontuacao;
+			}
+		}
+		if (escolhido < 0)
+			break;
+
+		removida_u = c->caminho[escolhido];
+		removida_v = c->caminho[escolhido+1];
+		backbite(c, escolhido);
+		distancia += variacao_escolhido;
+		//o proprio guia (distancia 0) ja eh conhecido, so interessam os intermediarios
+		if (distancia > 0 && pontuacao_escolhido > pontuacao_melhor){
+			pontuacao_melhor = pontuacao_escolhido;
+			for (int k = 1; k <= N; k++){
+				melhor[k-1] = c->caminho[k];
+			}
+		}
+	}
+	return pontuacao_melhor;
+}
@@ -0,0 +1,17 @@
+/*
+ * local_search.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef LOCAL_SEARCH_H_
+#define LOCAL_SEARCH_H_
+
+#include "hikerdice_grasp.h"
+
+void init_busca_local(contexto* c);
+int busca_local(contexto* c, int* solucao);
+int religar_caminhos(contexto* c, const int* inicio, const int* guia, int* melhor);
+
+#endif /* LOCAL_SEARCH_H_ */
@@ -0,0 +1,161 @@
+/*
+ * map_loader.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "map_loader.h"
+
+static uint32_t ler_u32(const unsigned char* p){
+	return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+
+static void escrever_u32(unsigned char* p, uint32_t v){
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+}
+
+/*A grade com a borda, (m+2)*(n+2) celulas, precisa caber num int (grid.tamanho e os indices)*/
+static bool dimensoes_validas(uint64_t m, uint64_t n){
+	return m > 0 && n > 0 && m <= INT_MAX && n <= INT_MAX && (m+2)*(n+2) <= INT_MAX;
+}
+
+/**Proximo inteiro nao negativo do texto, pulando separadores (virgulas, espacos, \r e \n).
+ * -1 no fim do arquivo, num sinal de menos ou num valor que nao cabe num int.
+ */
+static int proximo_inteiro(const char** cursor, const char* fim){
+	const char* p = *cursor;
+	while (p < fim && (*p < '0' || *p > '9')){
+		if (*p == '-')
+			return -1;
+		p++;
+	}
+	if (p == fim)
+		return -1;
+	int valor = 0;
+	while (p < fim && *p >= '0' && *p <= '9'){
+		int digito = *p++ - '0';
+		if (valor > (INT_MAX - digito) / 10)
+			return -1;
+		valor = valor*10 + digito;
+	}
+	*cursor = p;
+	return valor;
+}
+
+static bool carregar_texto(const char* dados, size_t tamanho, grid* g, int* qtd_livres){
+	const char* cursor = dados;
+	const char* fim = dados + tamanho;
+	int m = proximo_inteiro(&cursor, fim);
+	int n = proximo_inteiro(&cursor, fim);
+	if (m <= 0 || n <= 0 || !dimensoes_validas((uint64_t) m, (uint64_t) n))
+		return false;
+	//cada valor ocupa pelo menos um digito e um separador (o ultimo pode terminar o arquivo)
+	if ((uint64_t) m*n > ((uint64_t) (fim - cursor) + 1) / 2)
+		return false;
+
+	init_grid(g, m, n);
+	int livres = 0;
+	for (int i = 0; i < m; i++){
+		bool* linha = &g->black[grid_index(g, i, 0)];
+		for (int j = 0; j < n; j++){
+			int valor = proximo_inteiro(&cursor, fim);
+			if (valor < 0)
+				return false;
+			linha[j] = valor == 0;
+			livres += valor != 0;
+		}
+	}
+	*qtd_livres = livres;
+	return true;
+}
+
+static bool carregar_binario(const unsigned char* dados, size_t tamanho, grid* g, int* qtd_livres){
+	if (tamanho < MAPA_BINARIO_CABECALHO)
+		return false;
+	uint32_t m = ler_u32(dados + 4);
+	uint32_t n = ler_u32(dados + 8);
+	if (!dimensoes_validas(m, n) || (tamanho - MAPA_BINARIO_CABECALHO)*8 < (uint64_t) m*n)
+		return false;
+
+	init_grid(g, (int) m, (int) n);
+	const unsigned char* bits = dados + MAPA_BINARIO_CABECALHO;
+	int livres = 0;
+	size_t k = 0;
+	for (uint32_t i = 0; i < m; i++){
+		bool* linha = &g->black[grid_index(g, (int) i, 0)];
+		for (uint32_t j = 0; j < n; j++, k++){
+			bool livre = (bits[k >> 3] >> (k & 7)) & 1;
+			linha[j] = !livre;
+			livres += livre;
+		}
+	}
+	*qtd_livres = livres;
+	return true;
+}
+
+bool carregar_mapa(const char* caminho, grid* g, int* qtd_livres){
+	int fd = open(caminho, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0){
+		close(fd);
+		return false;
+	}
+	size_t tamanho = (size_t) st.st_size;
+	void* dados = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (dados == MAP_FAILED)
+		return false;
+	madvise(dados, tamanho, MADV_SEQUENTIAL);
+
+	bool ok;
+	if (tamanho >= 4 && memcmp(dados, MAPA_BINARIO_ASSINATURA, 4) == 0)
+		ok = carregar_binario((const unsigned char*) dados, tamanho, g, qtd_livres);
+	else
+		ok = carregar_texto((const char*) dados, tamanho, g, qtd_livres);
+
+	munmap(dados, tamanho);
+	return ok;
+}
+
+bool salvar_mapa_binario(const char* caminho, grid* g){
+	FILE* fp = fopen(caminho, "wb");
+	if (fp == NULL)
+		return false;
+
+	unsigned char cabecalho[MAPA_BINARIO_CABECALHO];
+	memcpy(cabecalho, MAPA_BINARIO_ASSINATURA, 4);
+	escrever_u32(cabecalho + 4, (uint32_t) g->m);
+	escrever_u32(cabecalho + 8, (uint32_t) g->n);
+	bool ok = fwrite(cabecalho, 1, sizeof(cabecalho), fp) == sizeof(cabecalho);
+
+	unsigned char byte = 0;
+	size_t k = 0;
+	for (int i = 0; i < g->m && ok; i++){
+		for (int j = 0; j < g->n && ok; j++, k++){
+			if (!g->black[grid_index(g, i, j)])
+				byte |= 1u << (k & 7);
+			if ((k & 7) == 7){
+				ok = fputc(byte, fp) != EOF;
+				byte = 0;
+			}
+		}
+	}
+	if (ok && (k & 7) != 0)
+		ok = fputc(byte, fp) != EOF;
+
+	return fclose(fp) == 0 && ok;
+}
@@ -0,0 +1,27 @@
+/*
+ * map_loader.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef MAP_LOADER_H_
+#define MAP_LOADER_H_
+
+#include <stdbool.h>
+#include "graph.h"
+
+/**Formato binario compacto do mapa:
+ * "HDG1", m e n (uint32 little endian) e depois m*n bits linha a linha (bit menos significativo primeiro),
+ * com 1 para celula livre e 0 para celula preta, como no formato texto.
+ */
+#define MAPA_BINARIO_ASSINATURA "HDG1"
+#define MAPA_BINARIO_CABECALHO 12
+
+/**Le o mapa (texto ou binario, detectado pela assinatura) mapeando o arquivo em memoria.
+ * Inicializa a grade e devolve a quantidade de celulas livres. Retorna false se o arquivo nao puder ser lido.
+ */
+bool carregar_mapa(const char* caminho, grid* g, int* qtd_livres);
+bool salvar_mapa_binario(const char* caminho, grid* g);
+
+#endif /* MAP_LOADER_H_ */
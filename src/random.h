@@ -0,0 +1,44 @@
+/*
+ * random.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <stdint.h>
+
+/**Gerador PCG32 (XSH RR): 64 bits de estado e um fluxo (incremento impar) por contexto.
+ * Com a mesma semente e o mesmo fluxo, a sequencia eh sempre a mesma, o que torna as execucoes repetiveis.
+ */
+typedef struct pcg{
+	uint64_t estado;
+	uint64_t incremento;
+} pcg32;
+
+static inline uint32_t pcg32_proximo(pcg32* r){
+	uint64_t anterior = r->estado;
+	r->estado = anterior * 6364136223846793005ULL + r->incremento;
+	uint32_t xorshifted = (uint32_t) (((anterior >> 18u) ^ anterior) >> 27u);
+	uint32_t rot = (uint32_t) (anterior >> 59u);
+	return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+static inline void pcg32_iniciar(pcg32* r, uint64_t semente, uint64_t fluxo){
+	r->estado = 0;
+	r->incremento = (fluxo << 1u) | 1u;
+	pcg32_proximo(r);
+	r->estado += semente;
+	pcg32_proximo(r);
+}
+
+/**Inteiro em [0, limite) com um unico sorteio (multiplicacao e shift, sem rejeicao).
+ * O vies eh menor que limite/2^32, desprezivel para os pesos pequenos da roleta.
+ */
+static inline uint32_t pcg32_limitado(pcg32* r, uint32_t limite){
+	return (uint32_t) (((uint64_t) pcg32_proximo(r) * limite) >> 32);
+}
+
+#endif /* RANDOM_H_ */
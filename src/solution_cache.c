@@ -0,0 +1,165 @@
+/*
+ * solution_cache.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "solution_cache.h"
+
+static void escrever_u32(unsigned char* p, uint32_t v){
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+}
+
+static uint32_t ler_u32(const unsigned char* p){
+	return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+
+static uint64_t fnv1a(uint64_t h, const void* dados, size_t tamanho){
+	const unsigned char* p = (const unsigned char*) dados;
+	for (size_t k = 0; k < tamanho; k++){
+		h ^= p[k];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+uint64_t hash_mapa(grid* g, int origem_i, int origem_j){
+	int dados[4] = {g->m, g->n, origem_i, origem_j};
+	uint64_t h = fnv1a(14695981039346656037ULL, dados, sizeof(dados));
+	for (int i = 0; i < g->m; i++)
+		h = fnv1a(h, &g->black[grid_index(g, i, 0)], sizeof(bool)*g->n);
+	return h;
+}
+
+static void caminho_arquivo(char* destino, size_t tamanho, const char* diretorio, uint64_t h, const char* extensao){
+	snprintf(destino, tamanho, "%s/%016llx%s", diretorio, (unsigned long long) h, extensao);
+}
+
+/*Bytes da grade empacotada, um bit por celula livre*/
+static size_t tamanho_grade(grid* g){
+	return ((size_t) g->m*g->n + 7) / 8;
+}
+
+/**Le o passeio do cache para 'solucao' (qtd vertices, terminando na origem).
+ * Retorna a pontuacao, refeita com as regras do dado, ou 0 se nao houver entrada valida.
+ */
+int cache_ler(const char* diretorio, grid* g, int origem_i, int origem_j, int* solucao, int qtd){
+	char caminho[4096];
+	caminho_arquivo(caminho, sizeof(caminho), diretorio, hash_mapa(g, origem_i, origem_j), ".hdc");
+	FILE* fp = fopen(caminho, "rb");
+	if (fp == NULL)
+		return 0;
+
+	size_t bytes_grade = tamanho_grade(g);
+	size_t tamanho = CACHE_CABECALHO + bytes_grade + ((size_t) qtd + 3) / 4;
+	unsigned char* dados = (unsigned char*) malloc(tamanho);
+	bool lido = fread(dados, 1, tamanho, fp) == tamanho;
+	fclose(fp);
+	if (!lido || memcmp(dados, CACHE_ASSINATURA, 4) != 0
+			|| ler_u32(dados + 4) != (uint32_t) g->m || ler_u32(dados + 8) != (uint32_t) g->n
+			|| ler_u32(dados + 12) != (uint32_t) origem_i || ler_u32(dados + 16) != (uint32_t) origem_j
+			|| ler_u32(dados + 20) != (uint32_t) qtd){
+		free(dados);
+		return 0;
+	}
+
+	//confere a grade (colisao de hash) e refaz o passeio
+	const unsigned char* bits_grade = dados + CACHE_CABECALHO;
+	for (size_t k = 0; k < (size_t) g->m*g->n; k++){
+		bool livre = (bits_grade[k >> 3] >> (k & 7)) & 1;
+		if (livre == g->black[grid_index(g, (int) (k / g->n), (int) (k % g->n))]){
+			free(dados);
+			return 0;
+		}
+	}
+	const unsigned char* movimentos = bits_grade + bytes_grade;
+	bool* visitado = (bool*) calloc(g->tamanho, sizeof(bool));
+	int origem = grid_index(g, origem_i, origem_j);
+	int atual = origem;
+	dice d = DICE_INICIAL;
+	int pontuacao = 0;
+	for (int k = 0; k < qtd && pontuacao >= 0; k++){
+		int direcao = (movimentos[k >> 2] >> ((k & 3) * 2)) & 3;
+		atual += g->deslocamento[direcao];
+		if (g->black[atual] || visitado[atual])
+			pontuacao = -1;
+		else {
+			visitado[atual] = true;
+			pontuacao += roll(&d, d, direcao);
+			solucao[k] = atual;
+		}
+	}
+	if (atual != origem)
+		pontuacao = -1;
+	free(visitado);
+	free(dados);
+	return pontuacao > 0 ? pontuacao : 0;
+}
+
+bool cache_gravar(const char* diretorio, grid* g, int origem_i, int origem_j, const int* solucao, int qtd, int pontuacao){
+	uint64_t h = hash_mapa(g, origem_i, origem_j);
+	char caminho[4096], temporario[4096], lock[4096];
+	caminho_arquivo(caminho, sizeof(caminho), diretorio, h, ".hdc");
+	caminho_arquivo(lock, sizeof(lock), diretorio, h, ".lock");
+	caminho_arquivo(temporario, sizeof(temporario), diretorio, h, ".XXXXXX");
+
+	size_t bytes_grade = tamanho_grade(g);
+	size_t tamanho = CACHE_CABECALHO + bytes_grade + ((size_t) qtd + 3) / 4;
+	unsigned char* dados = (unsigned char*) calloc(tamanho, 1);
+	memcpy(dados, CACHE_ASSINATURA, 4);
+	escrever_u32(dados + 4, (uint32_t) g->m);
+	escrever_u32(dados + 8, (uint32_t) g->n);
+	escrever_u32(dados + 12, (uint32_t) origem_i);
+	escrever_u32(dados + 16, (uint32_t) origem_j);
+	escrever_u32(dados + 20, (uint32_t) qtd);
+	escrever_u32(dados + 24, (uint32_t) pontuacao);
+	unsigned char* bits_grade = dados + CACHE_CABECALHO;
+	for (size_t k = 0; k < (size_t) g->m*g->n; k++){
+		if (!g->black[grid_index(g, (int) (k / g->n), (int) (k % g->n))])
+			bits_grade[k >> 3] |= 1u << (k & 7);
+	}
+	unsigned char* movimentos = bits_grade + bytes_grade;
+	int anterior = grid_index(g, origem_i, origem_j);
+	for (int k = 0; k < qtd; k++){
+		movimentos[k >> 2] |= grid_direcao(g, solucao[k], anterior) << ((k & 3) * 2);
+		anterior = solucao[k];
+	}
+
+	int fd = mkstemp(temporario);
+	bool ok = fd >= 0 && fchmod(fd, 0644) == 0;
+	for (size_t escrito = 0; ok && escrito < tamanho; ){
+		ssize_t n = write(fd, dados + escrito, tamanho - escrito);
+		ok = n > 0;
+		escrito += ok ? (size_t) n : 0;
+	}
+	if (fd >= 0)
+		ok = close(fd) == 0 && ok;
+	free(dados);
+
+	//troca o arquivo somente se a entrada atual (de outro processo, talvez) nao for melhor
+	int fd_lock = ok ? open(lock, O_CREAT | O_RDWR, 0644) : -1;
+	if (fd_lock >= 0 && flock(fd_lock, LOCK_EX) == 0){
+		int* atual = (int*) malloc(sizeof(int)*qtd);
+		ok = cache_ler(diretorio, g, origem_i, origem_j, atual, qtd) < pontuacao && rename(temporario, caminho) == 0;
+		free(atual);
+		flock(fd_lock, LOCK_UN);
+	}
+	else
+		ok = false;
+	if (fd_lock >= 0)
+		close(fd_lock);
+	if (!ok && fd >= 0)
+		unlink(temporario);
+	return ok;
+}
@@ -0,0 +1,28 @@
+/*
+ * solution_cache.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef SOLUTION_CACHE_H_
+#define SOLUTION_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "graph.h"
+
+/**Cache em disco da melhor solucao de cada (mapa, origem), um arquivo por chave: <diretorio>/<hash>.hdc.
+ * O hash (FNV-1a) cobre as dimensoes, as celulas e a origem; o arquivo guarda tambem a grade,
+ * conferida na leitura, e o passeio com 2 bits por movimento, que eh refeito e repontuado antes do uso.
+ * A gravacao escreve um arquivo temporario e o renomeia com um lock exclusivo (flock) em <hash>.lock,
+ * somente se a pontuacao for maior que a do cache, entao varios processos podem dividir o diretorio.
+ */
+#define CACHE_ASSINATURA "HDC1"
+#define CACHE_CABECALHO 28
+
+uint64_t hash_mapa(grid* g, int origem_i, int origem_j);
+int cache_ler(const char* diretorio, grid* g, int origem_i, int origem_j, int* solucao, int qtd);
+bool cache_gravar(const char* diretorio, grid* g, int origem_i, int origem_j, const int* solucao, int qtd, int pontuacao);
+
+#endif /* SOLUTION_CACHE_H_ */
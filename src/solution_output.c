@@ -0,0 +1,138 @@
+/*
+ * solution_output.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "solution_output.h"
+
+const char letra_movimento[4] = {'L', 'U', 'R', 'D'};//na ordem das direcoes ROLL_*
+
+/*Codifica os movimentos em run-length no buffer (tamanho minimo 2*qtd+1) e devolve o tamanho escrito*/
+static size_t codificar_rle(grid* g, int origem, const int* solucao, int qtd, char* buffer){
+	size_t k = 0;
+	int anterior = origem;
+	int i = 0;
+	while (i < qtd){
+		int direcao = grid_direcao(g, solucao[i], anterior);
+		int repeticoes = 0;
+		while (i < qtd && grid_direcao(g, solucao[i], anterior) == direcao){
+			anterior = solucao[i++];
+			repeticoes++;
+		}
+		buffer[k++] = letra_movimento[direcao];
+		if (repeticoes > 1)
+			k += sprintf(&buffer[k], "%d", repeticoes);
+	}
+	buffer[k] = '\0';
+	return k;
+}
+
+/**Escreve os movimentos do passeio em run-length, com um unico fwrite*/
+void imprimir_movimentos(FILE* fp, grid* g, int origem, const int* solucao, int qtd){
+	char* buffer = (char*) malloc(2*(size_t) qtd + 16);
+	size_t tamanho = codificar_rle(g, origem, solucao, qtd, buffer);
+	fwrite(buffer, 1, tamanho, fp);
+	free(buffer);
+}
+
+static void escrever_u32(unsigned char* p, uint32_t v){
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+}
+
+static uint32_t ler_u32(const unsigned char* p){
+	return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+
+bool salvar_movimentos(const char* caminho, grid* g, int origem, const int* solucao, int qtd, int pontuacao, bool binario){
+	FILE* fp = fopen(caminho, binario ? "wb" : "w");
+	if (fp == NULL)
+		return false;
+
+	bool ok;
+	if (binario){
+		size_t tamanho = MOVIMENTOS_CABECALHO + ((size_t) qtd + 3) / 4;
+		unsigned char* buffer = (unsigned char*) calloc(tamanho, 1);
+		memcpy(buffer, MOVIMENTOS_ASSINATURA, 4);
+		escrever_u32(buffer + 4, (uint32_t) qtd);
+		escrever_u32(buffer + 8, (uint32_t) pontuacao);
+		unsigned char* bits = buffer + MOVIMENTOS_CABECALHO;
+		int anterior = origem;
+		for (int i = 0; i < qtd; i++){
+			bits[i >> 2] |= grid_direcao(g, solucao[i], anterior) << ((i & 3) * 2);
+			anterior = solucao[i];
+		}
+		ok = fwrite(buffer, 1, tamanho, fp) == tamanho;
+		free(buffer);
+	}
+	else {
+		char* buffer = (char*) malloc(2*(size_t) qtd + 16);
+		size_t tamanho = codificar_rle(g, origem, solucao, qtd, buffer);
+		buffer[tamanho++] = '\n';
+		ok = fprintf(fp, "%d\n", pontuacao) > 0 && fwrite(buffer, 1, tamanho, fp) == tamanho;
+		free(buffer);
+	}
+
+	return fclose(fp) == 0 && ok;
+}
+
+/**Le um arquivo de movimentos (texto ou binario, detectado pela assinatura).
+ * Devolve um array com as direcoes ROLL_* (liberar com free), ou NULL se o arquivo for invalido.
+ */
+uint8_t* carregar_movimentos(const char* caminho, int* qtd, int* pontuacao){
+	FILE* fp = fopen(caminho, "rb");
+	if (fp == NULL)
+		return NULL;
+	fseek(fp, 0, SEEK_END);
+	long tamanho = ftell(fp);
+	rewind(fp);
+	unsigned char* dados = (unsigned char*) malloc((size_t) tamanho + 1);
+	if (tamanho <= 0 || fread(dados, 1, (size_t) tamanho, fp) != (size_t) tamanho){
+		free(dados);
+		fclose(fp);
+		return NULL;
+	}
+	fclose(fp);
+	dados[tamanho] = '\0';
+
+	uint8_t* movimentos = NULL;
+	if (tamanho >= MOVIMENTOS_CABECALHO && memcmp(dados, MOVIMENTOS_ASSINATURA, 4) == 0){
+		*qtd = (int) ler_u32(dados + 4);
+		*pontuacao = (int) ler_u32(dados + 8);
+		if ((size_t) (tamanho - MOVIMENTOS_CABECALHO) * 4 >= (size_t) *qtd){
+			movimentos = (uint8_t*) malloc((size_t) *qtd + 1);
+			const unsigned char* bits = dados + MOVIMENTOS_CABECALHO;
+			for (int i = 0; i < *qtd; i++)
+				movimentos[i] = (bits[i >> 2] >> ((i & 3) * 2)) & 3;
+		}
+	}
+	else {
+		char* p = (char*) dados;
+		*pontuacao = (int) strtol(p, &p, 10);
+		size_t capacidade = 1024;
+		movimentos = (uint8_t*) malloc(capacidade);
+		*qtd = 0;
+		while (*p != '\0'){
+			const char* letra = memchr(letra_movimento, *p++, 4);
+			if (letra == NULL)
+				continue;//espacos e quebras de linha
+			long repeticoes = 1;
+			if (*p >= '0' && *p <= '9')
+				repeticoes = strtol(p, &p, 10);
+			while ((size_t) *qtd + repeticoes > capacidade){
+				capacidade *= 2;
+				movimentos = (uint8_t*) realloc(movimentos, capacidade);
+			}
+			for (long r = 0; r < repeticoes; r++)
+				movimentos[(*qtd)++] = (uint8_t) (letra - letra_movimento);
+		}
+	}
+	free(dados);
+	return movimentos;
+}
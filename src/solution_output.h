@@ -0,0 +1,30 @@
+/*
+ * solution_output.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef SOLUTION_OUTPUT_H_
+#define SOLUTION_OUTPUT_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "graph.h"
+
+/**Passeio completo como sequencia de movimentos a partir da origem (direcoes ROLL_* do dice.h).
+ * Texto: pontuacao na primeira linha e os movimentos L/U/R/D com run-length na segunda (ex.: R5DL5D).
+ * Binario: "HDM1", quantidade de movimentos e pontuacao (uint32/int32 little endian),
+ * e depois 2 bits por movimento (bits menos significativos primeiro).
+ */
+#define MOVIMENTOS_ASSINATURA "HDM1"
+#define MOVIMENTOS_CABECALHO 12
+
+extern const char letra_movimento[4];
+
+void imprimir_movimentos(FILE* fp, grid* g, int origem, const int* solucao, int qtd);
+bool salvar_movimentos(const char* caminho, grid* g, int origem, const int* solucao, int qtd, int pontuacao, bool binario);
+uint8_t* carregar_movimentos(const char* caminho, int* qtd, int* pontuacao);
+
+#endif /* SOLUTION_OUTPUT_H_ */
@@ -0,0 +1,63 @@
+/*
+ * symmetry.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include "symmetry.h"
+
+int qtd_simetrias;
+int simetrias[MAX_SIMETRIAS];
+
+void detectar_simetrias(grid* g){
+	qtd_simetrias = 0;
+	for (int s = 0; s < MAX_SIMETRIAS; s++){
+		if ((s & SIMETRIA_TRANSPOE) && g->m != g->n)
+			continue;
+		bool preserva = true;
+		for (int i = 0; i < g->m && preserva; i++){
+			for (int j = 0; j < g->n && preserva; j++){
+				int idx = grid_index(g, i, j);
+				preserva = g->black[idx] == g->black[aplicar_simetria(g, s, idx)];
+			}
+		}
+		if (preserva)
+			simetrias[qtd_simetrias++] = s;
+	}
+}
+
+int melhor_imagem_simetrica(grid* g, int origem, const int* solucao, int total, int* melhor, int* imagem){
+	int melhor_pontuacao = 0;
+	for (int k = 0; k < qtd_simetrias; k++){
+		int s = simetrias[k];
+		//o ciclo eh origem, solucao[0..total-2]; a imagem comeca onde o ciclo passa pela pre-imagem da origem
+		int inicio = total - 1;
+		for (int p = 0; p < total - 1; p++){
+			if (aplicar_simetria(g, s, solucao[p]) == origem){
+				inicio = p;
+				break;
+			}
+		}
+		for (int sentido = (s == 0); sentido < 2; sentido++){
+			dice d = DICE_INICIAL;
+			int pontuacao = 0;
+			int anterior = origem;
+			for (int t = 1; t <= total; t++){
+				//posicao no ciclo (0 = origem, p+1 = solucao[p]) 't' passos depois da pre-imagem da origem
+				int pos = (inicio + 1 + (sentido == 0 ? t : total - t)) % total;
+				int atual = aplicar_simetria(g, s, pos == 0 ? origem : solucao[pos-1]);
+				imagem[t-1] = atual;
+				pontuacao += roll(&d, d, grid_direcao(g, atual, anterior));
+				anterior = atual;
+			}
+			if (pontuacao > melhor_pontuacao){
+				melhor_pontuacao = pontuacao;
+				memcpy(melhor, imagem, sizeof(int)*total);
+			}
+		}
+	}
+	return melhor_pontuacao;
+}
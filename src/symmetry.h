@@ -0,0 +1,46 @@
+/*
+ * symmetry.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef SYMMETRY_H_
+#define SYMMETRY_H_
+
+#include "graph.h"
+
+//transformacoes do retangulo: bit 0 espelha as linhas, bit 1 as colunas e bit 2 troca linha e coluna
+#define MAX_SIMETRIAS 8
+#define SIMETRIA_ESPELHA_I 1
+#define SIMETRIA_ESPELHA_J 2
+#define SIMETRIA_TRANSPOE 4
+
+/**Automorfismos do mapa: as transformacoes do retangulo (as que trocam linha e coluna so em mapas
+ * quadrados) que levam casas livres em casas livres. A identidade eh sempre a primeira.
+ * Um automorfismo nao preserva a pontuacao: girar o mapa equivale a girar o dado inicial em torno do eixo
+ * vertical, e espelhar troca a quiralidade do dado, entao ramos simetricos da busca nao sao equivalentes e
+ * nao podem ser podados. Mas a imagem de um ciclo hamiltoniano continua sendo um ciclo hamiltoniano (e
+ * passa pela origem), entao cada passeio encontrado rende ate 2*qtd_simetrias passeios para avaliar.
+ */
+extern int qtd_simetrias;
+extern int simetrias[MAX_SIMETRIAS];
+
+void detectar_simetrias(grid* g);
+
+static inline int aplicar_simetria(grid* g, int simetria, int idx){
+	int i = grid_i(g, idx), j = grid_j(g, idx);
+	if (simetria & SIMETRIA_ESPELHA_I)
+		i = g->m - 1 - i;
+	if (simetria & SIMETRIA_ESPELHA_J)
+		j = g->n - 1 - j;
+	return simetria & SIMETRIA_TRANSPOE ? grid_index(g, j, i) : grid_index(g, i, j);
+}
+
+/**Avalia a imagem do passeio por cada automorfismo, nos dois sentidos (exceto o proprio passeio),
+ * recomecando cada uma na origem. Grava a de maior pontuacao em 'melhor' e retorna a pontuacao dela.
+ * 'imagem' eh um buffer de trabalho; os dois tem 'total' posicoes, no formato de melhor_solucao.
+ */
+int melhor_imagem_simetrica(grid* g, int origem, const int* solucao, int total, int* melhor, int* imagem);
+
+#endif /* SYMMETRY_H_ */
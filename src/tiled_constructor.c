@@ -0,0 +1,379 @@
+/*
+ * tiled_constructor.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "tiled_constructor.h"
+
+#define LADO_MAXIMO 4
+#define ESTADOS_BLOCO (LADO_MAXIMO*24)//posicao na borda de saida x orientacao do dado
+#define ORCAMENTO_BLOCOS (1 << 16)//blocos processados pela programacao dinamica, somando as tentativas do bloco da origem
+
+/**Todos os caminhos hamiltonianos (com sentido) de um retangulo h x w, como sequencias de celulas locais r*w + c*/
+typedef struct{
+	bool pronto;
+	int qtd;
+	int capacidade;
+	uint8_t* celulas;//qtd*h*w
+} padroes_forma;
+
+typedef struct{
+	uint8_t estado_saida;//posicao*24 + dado na celula de saida
+	int16_t pontos;
+	uint16_t padrao;
+} transicao;
+
+/**Melhores padroes de um formato de bloco para um par de lados de entrada e saida.
+ * Para cada estado de entrada (posicao na borda de entrada e dado da celula anterior, fora do bloco),
+ * guarda so o melhor padrao para cada estado de saida, em transicoes[primeira[e] .. primeira[e+1]).
+ */
+typedef struct{
+	bool pronto;
+	int primeira[ESTADOS_BLOCO+1];
+	transicao* transicoes;
+} tipo_bloco;
+
+typedef struct{
+	int linha, coluna;//celula do canto superior esquerdo
+	int h, w;
+	int entrada, saida;//lado voltado para o bloco anterior e para o proximo (direcoes do dice.h)
+	tipo_bloco* tipo;
+} bloco;
+
+typedef struct{
+	uint16_t padrao;
+	uint8_t anterior;//estado de saida do bloco anterior
+} escolha_bloco;
+
+//nao dependem do mapa, ficam calculados entre os jobs do modo lote
+static padroes_forma formas[LADO_MAXIMO-1][LADO_MAXIMO-1];
+static tipo_bloco tipos[LADO_MAXIMO-1][LADO_MAXIMO-1][4][4];
+
+/*Direcao do movimento entre duas celulas locais vizinhas de um bloco de largura w*/
+static int direcao_local(int w, int de, int para){
+	int diferenca = para - de;
+	if (diferenca == -1) return ROLL_LEFT;
+	if (diferenca == -w) return ROLL_UP;
+	if (diferenca == 1) return ROLL_RIGHT;
+	return ROLL_DOWN;
+}
+
+/*Posicao da celula local na borda do lado dado (linha nas bordas esquerda e direita, coluna nas outras), ou -1*/
+static int posicao_na_borda(int h, int w, int lado, int celula){
+	int r = celula / w, c = celula % w;
+	switch (lado){
+	case ROLL_LEFT: return c == 0 ? r : -1;
+	case ROLL_RIGHT: return c == w-1 ? r : -1;
+	case ROLL_UP: return r == 0 ? c : -1;
+	default: return r == h-1 ? c : -1;
+	}
+}
+
+static void enumerar_caminhos(padroes_forma* f, int h, int w, uint8_t* caminho, bool* usado, int k){
+	int n = h*w;
+	if (k == n){
+		if (f->qtd == f->capacidade){
+			f->capacidade = f->capacidade == 0 ? 256 : 2*f->capacidade;
+			f->celulas = realloc(f->celulas, (size_t) f->capacidade*n);
+		}
+		memcpy(&f->celulas[(size_t) f->qtd*n], caminho, n);
+		f->qtd++;
+		return;
+	}
+	static const int dr[4] = {0, -1, 0, 1};
+	static const int dc[4] = {-1, 0, 1, 0};
+	int r = caminho[k-1] / w, c = caminho[k-1] % w;
+	for (int d = 0; d < 4; d++){
+		int nr = r + dr[d], nc = c + dc[d];
+		if (nr < 0 || nr >= h || nc < 0 || nc >= w || usado[nr*w + nc])
+			continue;
+		usado[nr*w + nc] = true;
+		caminho[k] = (uint8_t) (nr*w + nc);
+		enumerar_caminhos(f, h, w, caminho, usado, k+1);
+		usado[nr*w + nc] = false;
+	}
+}
+
+static padroes_forma* forma(int h, int w){
+	padroes_forma* f = &formas[h-2][w-2];
+	if (f->pronto)
+		return f;
+	uint8_t caminho[LADO_MAXIMO*LADO_MAXIMO];
+	bool usado[LADO_MAXIMO*LADO_MAXIMO] = {0};
+	for (int inicio = 0; inicio < h*w; inicio++){
+		usado[inicio] = true;
+		caminho[0] = (uint8_t) inicio;
+		enumerar_caminhos(f, h, w, caminho, usado, 1);
+		usado[inicio] = false;
+	}
+	f->pronto = true;
+	return f;
+}
+
+/*Pontuacao de rolar o dado *d pelas celulas caminho[de..ate] de um bloco (a primeira rolagem sai de caminho[de-1])*/
+static int rolar_padrao(dice* d, const uint8_t* caminho, int w, int de, int ate){
+	int pontos = 0;
+	for (int k = de; k <= ate; k++){
+		pontos += roll(d, *d, direcao_local(w, caminho[k-1], caminho[k]));
+	}
+	return pontos;
+}
+
+static tipo_bloco* tipo(int h, int w, int entrada, int saida){
+	tipo_bloco* t = &tipos[h-2][w-2][entrada][saida];
+	if (t->pronto)
+		return t;
+	padroes_forma* f = forma(h, w);
+	int n = h*w;
+	int16_t* pontos = malloc(sizeof(int16_t)*ESTADOS_BLOCO*ESTADOS_BLOCO);
+	uint16_t* padrao = malloc(sizeof(uint16_t)*ESTADOS_BLOCO*ESTADOS_BLOCO);
+	for (int e = 0; e < ESTADOS_BLOCO*ESTADOS_BLOCO; e++){
+		pontos[e] = -1;
+	}
+
+	int direcao_entrada = (entrada+2) % 4;//o bloco anterior fica do lado de entrada
+	for (int k = 0; k < f->qtd; k++){
+		const uint8_t* caminho = &f->celulas[(size_t) k*n];
+		int posicao_entrada = posicao_na_borda(h, w, entrada, caminho[0]);
+		int posicao_saida = posicao_na_borda(h, w, saida, caminho[n-1]);
+		if (posicao_entrada < 0 || posicao_saida < 0)
+			continue;
+		for (int anterior = 0; anterior < 24; anterior++){
+			dice d;
+			int s = roll(&d, (dice) anterior, direcao_entrada) + rolar_padrao(&d, caminho, w, 1, n-1);
+			int e = (posicao_entrada*24 + anterior)*ESTADOS_BLOCO + posicao_saida*24 + d;
+			if (s > pontos[e]){
+				pontos[e] = (int16_t) s;
+				padrao[e] = (uint16_t) k;
+			}
+		}
+	}
+
+	int qtd = 0;
+	for (int e = 0; e < ESTADOS_BLOCO*ESTADOS_BLOCO; e++){
+		qtd += pontos[e] >= 0;
+	}
+	t->transicoes = malloc(sizeof(transicao)*(qtd > 0 ? qtd : 1));
+	qtd = 0;
+	for (int e = 0; e < ESTADOS_BLOCO; e++){
+		t->primeira[e] = qtd;
+		for (int s = 0; s < ESTADOS_BLOCO; s++){
+			if (pontos[e*ESTADOS_BLOCO + s] >= 0){
+				t->transicoes[qtd].estado_saida = (uint8_t) s;
+				t->transicoes[qtd].pontos = pontos[e*ESTADOS_BLOCO + s];
+				t->transicoes[qtd].padrao = padrao[e*ESTADOS_BLOCO + s];
+				qtd++;
+			}
+		}
+	}
+	t->primeira[ESTADOS_BLOCO] = qtd;
+	free(pontos);
+	free(padrao);
+	t->pronto = true;
+	return t;
+}
+
+/*Divide L celulas em K partes de 2 a 4 (so pares se L for par, para que todo bloco tenha area par).
+ *Na variante 0 as partes maiores ficam espalhadas, na 1 ficam no fim*/
+static void dividir(int L, int K, int* partes, int variante){
+	int unidade = L % 2 == 0 ? 2 : 1;
+	int total = L / unidade;
+	for (int i = 0; i < K; i++){
+		partes[i] = unidade * (total*(i+1)/K - total*i/K);
+	}
+	if (variante == 1){
+		int menor = unidade * (total/K), qtd_maiores = total % K;
+		for (int i = 0; i < K; i++){
+			partes[i] = i < K - qtd_maiores ? menor : menor + unidade;
+		}
+	}
+}
+
+/*Programacao dinamica sobre os blocos 1..qtd-1, partindo do estado de saida do bloco 0.
+ *Deixa em valor[] a melhor pontuacao para cada estado de saida do ultimo bloco (-1 se inalcancavel)*/
+static void programacao_dinamica(bloco* blocos, int qtd, int estado_inicial, escolha_bloco* escolhas, int* valor){
+	int proximo[ESTADOS_BLOCO];
+	for (int s = 0; s < ESTADOS_BLOCO; s++){
+		valor[s] = -1;
+	}
+	valor[estado_inicial] = 0;
+	for (int b = 1; b < qtd; b++){
+		tipo_bloco* t = blocos[b].tipo;
+		escolha_bloco* escolha = &escolhas[(size_t) b*ESTADOS_BLOCO];
+		for (int s = 0; s < ESTADOS_BLOCO; s++){
+			proximo[s] = -1;
+		}
+		for (int s = 0; s < ESTADOS_BLOCO; s++){
+			if (valor[s] < 0)
+				continue;
+			for (int k = t->primeira[s]; k < t->primeira[s+1]; k++){
+				transicao* tr = &t->transicoes[k];
+				int v = valor[s] + tr->pontos;
+				if (v > proximo[tr->estado_saida]){
+					proximo[tr->estado_saida] = v;
+					escolha[tr->estado_saida].padrao = tr->padrao;
+					escolha[tr->estado_saida].anterior = (uint8_t) s;
+				}
+			}
+		}
+		memcpy(valor, proximo, sizeof(proximo));
+	}
+}
+
+/*Grava as celulas caminho[de..ate] do bloco b em solucao, a partir de *k*/
+static void gravar_celulas(grid* g, bloco* b, const uint8_t* caminho, int de, int ate, int* solucao, int* k){
+	for (int i = de; i <= ate; i++){
+		solucao[(*k)++] = grid_index(g, b->linha + caminho[i] / b->w, b->coluna + caminho[i] % b->w);
+	}
+}
+
+static int construir(grid* g, int origem, int* solucao, int variante){
+	int m = g->m, n = g->n;
+
+	//quantidade par de faixas de blocos, para que o pente sobre a grade de blocos feche um ciclo
+	int R = 2*((m+7)/8), C = 2*((n+7)/8);
+	int* alturas = malloc(sizeof(int)*R);
+	int* larguras = malloc(sizeof(int)*C);
+	dividir(m, R, alturas, variante);
+	dividir(n, C, larguras, variante);
+	int* inicio_linha = malloc(sizeof(int)*(R+1));
+	int* inicio_coluna = malloc(sizeof(int)*(C+1));
+	inicio_linha[0] = inicio_coluna[0] = 0;
+	for (int r = 0; r < R; r++) inicio_linha[r+1] = inicio_linha[r] + alturas[r];
+	for (int c = 0; c < C; c++) inicio_coluna[c+1] = inicio_coluna[c] + larguras[c];
+
+	//ciclo de blocos: desce pela primeira coluna e volta em zigue-zague pelas demais, de baixo para cima
+	int K = R*C;
+	int* ordem_r = malloc(sizeof(int)*K);
+	int* ordem_c = malloc(sizeof(int)*K);
+	int k = 0;
+	for (int r = 0; r < R; r++){
+		ordem_r[k] = r; ordem_c[k++] = 0;
+	}
+	for (int r = R-1; r >= 0; r--){
+		bool para_direita = (R-1-r) % 2 == 0;
+		for (int i = 1; i < C; i++){
+			ordem_r[k] = r; ordem_c[k++] = para_direita ? i : C-i;
+		}
+	}
+
+	//o ciclo comeca no bloco da origem
+	int oi = grid_i(g, origem), oj = grid_j(g, origem);
+	int primeiro = 0;
+	for (k = 0; k < K; k++){
+		int r = ordem_r[k], c = ordem_c[k];
+		if (oi >= inicio_linha[r] && oi < inicio_linha[r+1] && oj >= inicio_coluna[c] && oj < inicio_coluna[c+1])
+			primeiro = k;
+	}
+	bloco* blocos = malloc(sizeof(bloco)*K);
+	for (k = 0; k < K; k++){
+		int atual = (primeiro + k) % K, seguinte = (primeiro + k + 1) % K;
+		bloco* b = &blocos[k];
+		b->linha = inicio_linha[ordem_r[atual]];
+		b->coluna = inicio_coluna[ordem_c[atual]];
+		b->h = alturas[ordem_r[atual]];
+		b->w = larguras[ordem_c[atual]];
+		int dr = ordem_r[seguinte] - ordem_r[atual], dc = ordem_c[seguinte] - ordem_c[atual];
+		b->saida = dc < 0 ? ROLL_LEFT : dr < 0 ? ROLL_UP : dc > 0 ? ROLL_RIGHT : ROLL_DOWN;
+	}
+	for (k = 0; k < K; k++){
+		bloco* b = &blocos[k];
+		b->entrada = (blocos[(k+K-1) % K].saida + 2) % 4;
+		b->tipo = tipo(b->h, b->w, b->entrada, b->saida);
+	}
+
+	//o bloco da origem eh percorrido em duas partes: da origem ate a saida no comeco do passeio,
+	//e da entrada ate a origem no fim. Cada padrao dele eh uma tentativa com a sua propria programacao dinamica
+	bloco* b0 = &blocos[0];
+	int n0 = b0->h * b0->w;
+	int origem_local = (oi - b0->linha)*b0->w + (oj - b0->coluna);
+	padroes_forma* f0 = forma(b0->h, b0->w);
+	int qtd_candidatos = 0;
+	for (int p = 0; p < f0->qtd; p++){
+		const uint8_t* caminho = &f0->celulas[(size_t) p*n0];
+		qtd_candidatos += posicao_na_borda(b0->h, b0->w, b0->entrada, caminho[0]) >= 0
+				&& posicao_na_borda(b0->h, b0->w, b0->saida, caminho[n0-1]) >= 0;
+	}
+	int tentativas = ORCAMENTO_BLOCOS / K;
+	if (tentativas < 1) tentativas = 1;
+	if (tentativas > qtd_candidatos) tentativas = qtd_candidatos;
+
+	escolha_bloco* escolhas = malloc(sizeof(escolha_bloco)*ESTADOS_BLOCO*K);
+	uint16_t* padroes = malloc(sizeof(uint16_t)*K);
+	int valor[ESTADOS_BLOCO];
+	int melhor = 0;
+	int candidato = 0;
+	int proxima_tentativa = 0;
+	for (int p = 0; p < f0->qtd && proxima_tentativa < tentativas; p++){
+		const uint8_t* caminho = &f0->celulas[(size_t) p*n0];
+		int posicao_entrada = posicao_na_borda(b0->h, b0->w, b0->entrada, caminho[0]);
+		int posicao_saida = posicao_na_borda(b0->h, b0->w, b0->saida, caminho[n0-1]);
+		if (posicao_entrada < 0 || posicao_saida < 0)
+			continue;
+		//tentativas espalhadas uniformemente entre os candidatos
+		if (candidato++ != (int) ((long long) proxima_tentativa*qtd_candidatos/tentativas))
+			continue;
+		proxima_tentativa++;
+
+		int k0 = 0;
+		while (caminho[k0] != origem_local) k0++;
+		dice d = DICE_INICIAL;
+		int pontos_inicio = rolar_padrao(&d, caminho, b0->w, k0+1, n0-1);
+		programacao_dinamica(blocos, K, posicao_saida*24 + d, escolhas, valor);
+
+		//volta ao bloco da origem pela posicao de entrada do padrao
+		for (int anterior = 0; anterior < 24; anterior++){
+			int s = posicao_entrada*24 + anterior;
+			if (valor[s] < 0)
+				continue;
+			d = (dice) anterior;
+			int pontos = pontos_inicio + valor[s] + roll(&d, d, (b0->entrada+2) % 4)
+					+ rolar_padrao(&d, caminho, b0->w, 1, k0);
+			if (pontos <= melhor)
+				continue;
+			melhor = pontos;
+
+			for (int b = K-1; b >= 1; b--){
+				escolha_bloco* e = &escolhas[(size_t) b*ESTADOS_BLOCO + s];
+				padroes[b] = e->padrao;
+				s = e->anterior;
+			}
+			k = 0;
+			gravar_celulas(g, b0, caminho, k0+1, n0-1, solucao, &k);
+			for (int b = 1; b < K; b++){
+				int nb = blocos[b].h * blocos[b].w;
+				gravar_celulas(g, &blocos[b], &forma(blocos[b].h, blocos[b].w)->celulas[(size_t) padroes[b]*nb],
+						0, nb-1, solucao, &k);
+			}
+			gravar_celulas(g, b0, caminho, 0, k0, solucao, &k);
+		}
+	}
+
+	free(alturas);
+	free(larguras);
+	free(inicio_linha);
+	free(inicio_coluna);
+	free(ordem_r);
+	free(ordem_c);
+	free(blocos);
+	free(escolhas);
+	free(padroes);
+	return melhor;
+}
+
+/*Com algumas divisoes (faixas de altura impar alternadas com as de altura par) a paridade das posicoes
+ *de entrada e saida nao fecha o ciclo; nesse caso tenta a outra variante da divisao*/
+int construir_passeio_em_blocos(grid* g, int origem, int total, int* solucao){
+	if (total != g->m*g->n || g->m < 4 || g->n < 4 || total % 2 != 0)
+		return 0;
+	int pontuacao = 0;
+	for (int variante = 0; variante < 2 && pontuacao == 0; variante++){
+		pontuacao = construir(g, origem, solucao, variante);
+	}
+	return pontuacao;
+}
@@ -0,0 +1,24 @@
+/*
+ * tiled_constructor.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef TILED_CONSTRUCTOR_H_
+#define TILED_CONSTRUCTOR_H_
+
+#include "graph.h"
+
+/**Construtor estrutural para mapas sem casas pretas, em O(mn).
+ * A grade eh dividida em blocos de 2 a 4 celulas de lado, percorridos num ciclo fixo (um pente sobre
+ * a grade de blocos). Cada bloco eh coberto por um dos seus caminhos hamiltonianos pre-calculados,
+ * da celula de entrada ate a celula de saida, e a combinacao de caminhos eh escolhida por programacao
+ * dinamica sobre (posicao de saida, orientacao do dado), entao a pontuacao eh a melhor possivel
+ * dentro dessa estrutura.
+ * Grava o passeio em 'solucao' (no formato de melhor_solucao, terminando na origem) e retorna a
+ * pontuacao, ou 0 se o mapa nao se encaixa (casas pretas, lado menor que 4 ou quantidade impar de casas).
+ */
+int construir_passeio_em_blocos(grid* g, int origem, int total, int* solucao);
+
+#endif /* TILED_CONSTRUCTOR_H_ */
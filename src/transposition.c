@@ -0,0 +1,66 @@
+/*
+ * transposition.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "transposition.h"
+#include "random.h"
+
+uint64_t* zobrist_visitada;
+uint64_t* zobrist_atual;
+uint64_t zobrist_dado[24];
+_Atomic uint64_t* tabela_transposicao;
+uint64_t mascara_transposicao;
+bool transposicao_ativa;
+int megabytes_transposicao = MEGABYTES_TRANSPOSICAO_PADRAO;
+
+#define PAGINA_GRANDE (1u << 21)
+
+static uint64_t sortear_chave(pcg32* gerador){
+	return (uint64_t) pcg32_proximo(gerador) << 32 | pcg32_proximo(gerador);
+}
+
+void tt_preparar(grid* g, int limite_superior){
+	static int capacidade = 0;
+	static uint64_t geracao = 0;//cada mapa sorteia chaves novas, invalidando as entradas dos anteriores
+	transposicao_ativa = false;
+	if (megabytes_transposicao <= 0 || limite_superior >= (1 << BITS_PONTUACAO_TT))
+		return;
+	if (tabela_transposicao == NULL){
+		//maior potencia de 2 de entradas que cabe na memoria pedida (no minimo uma pagina grande)
+		uint64_t entradas = PAGINA_GRANDE / sizeof(uint64_t);
+		while (entradas*2*sizeof(uint64_t) <= (uint64_t) megabytes_transposicao << 20)
+			entradas *= 2;
+		size_t bytes = entradas*sizeof(uint64_t);
+		void* memoria = aligned_alloc(PAGINA_GRANDE, bytes);
+		if (memoria == NULL)
+			return;
+#ifdef MADV_HUGEPAGE
+		//acessos aleatorios: paginas de 2 MB cortam os page faults e as faltas de TLB
+		madvise(memoria, bytes, MADV_HUGEPAGE);
+#endif
+		memset(memoria, 0, bytes);
+		tabela_transposicao = (_Atomic uint64_t*) memoria;
+		mascara_transposicao = entradas - 1;
+	}
+	if (g->tamanho > capacidade){
+		zobrist_visitada = (uint64_t*) realloc(zobrist_visitada, sizeof(uint64_t)*g->tamanho);
+		zobrist_atual = (uint64_t*) realloc(zobrist_atual, sizeof(uint64_t)*g->tamanho);
+		capacidade = g->tamanho;
+	}
+	pcg32 gerador;
+	pcg32_iniciar(&gerador, 0x7a0b15ULL, geracao++);
+	for (int idx = 0; idx < g->tamanho; idx++){
+		zobrist_visitada[idx] = sortear_chave(&gerador);
+		zobrist_atual[idx] = sortear_chave(&gerador);
+	}
+	for (int d = 0; d < 24; d++){
+		zobrist_dado[d] = sortear_chave(&gerador);
+	}
+	transposicao_ativa = true;
+}
@@ -0,0 +1,56 @@
+/*
+ * transposition.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef TRANSPOSITION_H_
+#define TRANSPOSITION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "graph.h"
+
+#define MEGABYTES_TRANSPOSICAO_PADRAO 16
+#define BITS_PONTUACAO_TT 24//a entrada guarda a pontuacao nos bits baixos e confere a chave com os demais
+
+/**Tabela de transposicao da busca em profundidade, compartilhada pelos workers sem locks.
+ * O estado eh o conjunto de celulas visitadas (hash de Zobrist mantido por visitar()/desvisitar()),
+ * a celula atual e a orientacao do dado. Um estado so eh gravado quando a busca sai dele, com a subarvore
+ * esgotada: nenhuma continuacao dele passou da incumbente da epoca, que so cresce, entao quem chega ao
+ * mesmo estado com pontuacao parcial menor ou igual tambem nao passa e eh podado. Por isso a poda vale no
+ * modo exato e entre os restarts. Cada entrada eh um uint64 atomico (substituicao sempre), e as chaves
+ * de Zobrist sao sorteadas de novo a cada mapa, entao a tabela nao precisa ser limpa entre os jobs.
+ */
+extern uint64_t* zobrist_visitada;//por celula da grade
+extern uint64_t* zobrist_atual;//por celula da grade
+extern uint64_t zobrist_dado[24];
+extern _Atomic uint64_t* tabela_transposicao;
+extern uint64_t mascara_transposicao;
+extern bool transposicao_ativa;//tabela alocada e pontuacao maxima do mapa cabe na entrada
+extern int megabytes_transposicao;//-m: memoria da tabela (0 desliga)
+
+/*Sorteia as chaves para a grade e aloca a tabela na primeira vez*/
+void tt_preparar(grid* g, int limite_superior);
+
+static inline uint64_t tt_chave(uint64_t hash_visitadas, int atual, dice d){
+	return hash_visitadas ^ zobrist_atual[atual] ^ zobrist_dado[d];
+}
+
+/*O estado ja foi esgotado com pontuacao parcial maior ou igual*/
+static inline bool tt_dominado(uint64_t chave, int pontuacao){
+	uint64_t entrada = atomic_load_explicit(&tabela_transposicao[chave & mascara_transposicao], memory_order_relaxed);
+	return (entrada >> BITS_PONTUACAO_TT) == (chave >> BITS_PONTUACAO_TT)
+			&& (int) (entrada & ((1ULL << BITS_PONTUACAO_TT) - 1)) >= pontuacao;
+}
+
+static inline void tt_gravar(uint64_t chave, int pontuacao){
+	if (tt_dominado(chave, pontuacao))
+		return;
+	atomic_store_explicit(&tabela_transposicao[chave & mascara_transposicao],
+			(chave >> BITS_PONTUACAO_TT << BITS_PONTUACAO_TT) | (uint64_t) pontuacao, memory_order_relaxed);
+}
+
+#endif /* TRANSPOSITION_H_ */
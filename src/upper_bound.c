@@ -0,0 +1,74 @@
+/*
+ * upper_bound.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "upper_bound.h"
+
+#define PERIODO_MAXIMO 32
+
+int* pontuacao_max_para_cada_numero_jogadas;
+int jogadas_tabeladas;
+int periodo_limite;
+int ganho_periodo;
+
+/*Verifica se a linha k eh a linha k-p somada de uma mesma constante em todos os estados*/
+static bool linha_periodica(int k, int p, int* ganho){
+	int* linha = &pontuacao_max_para_cada_numero_jogadas[k*ESTADOS_LIMITE];
+	int* anterior = &pontuacao_max_para_cada_numero_jogadas[(k-p)*ESTADOS_LIMITE];
+	*ganho = linha[0] - anterior[0];
+	for (int e = 1; e < ESTADOS_LIMITE; e++){
+		if (linha[e] - anterior[e] != *ganho)
+			return false;
+	}
+	return true;
+}
+
+/** Configura a tabela de pontuacao maxima para N jogadas, por programacao dinamica:
+ * max[k][(o, ultima)] = maior entre as direcoes d != inversa(ultima) de bottom(roll(o,d)) + max[k-1][(roll(o,d), d)].
+ * A recorrencia eh max-plus, entao assim que uma linha k for a linha k-p mais uma constante,
+ * todas as seguintes tambem serao, e o calculo para ai (em poucas jogadas, independente do mapa).
+ */
+void config_pontuacao_max(){
+	int capacidade = 64;
+	pontuacao_max_para_cada_numero_jogadas = malloc(sizeof(int)*capacidade*ESTADOS_LIMITE);
+	for (int e = 0; e < ESTADOS_LIMITE; e++){
+		pontuacao_max_para_cada_numero_jogadas[e] = 0;
+	}
+
+	for (int k = 1; ; k++){
+		if (k == capacidade){
+			capacidade *= 2;
+			pontuacao_max_para_cada_numero_jogadas = realloc(pontuacao_max_para_cada_numero_jogadas,
+					sizeof(int)*capacidade*ESTADOS_LIMITE);
+		}
+		int* linha = &pontuacao_max_para_cada_numero_jogadas[k*ESTADOS_LIMITE];
+		int* anterior = &pontuacao_max_para_cada_numero_jogadas[(k-1)*ESTADOS_LIMITE];
+		for (int o = 0; o < 24; o++){
+			for (int ultima = 0; ultima <= DIRECAO_NENHUMA; ultima++){
+				int melhor = 0;
+				for (int d = 0; d < 4; d++){
+					if (ultima != DIRECAO_NENHUMA && d == (ultima+2) % 4)
+						continue;
+					dice rolado = dice_roll[o][d];
+					int pontos = dice_bottom[rolado] + anterior[rolado*5 + d];
+					if (pontos > melhor)
+						melhor = pontos;
+				}
+				linha[o*5 + ultima] = melhor;
+			}
+		}
+
+		for (int p = 1; p <= k && p <= PERIODO_MAXIMO; p++){
+			if (linha_periodica(k, p, &ganho_periodo)){
+				jogadas_tabeladas = k;
+				periodo_limite = p;
+				return;
+			}
+		}
+	}
+}
@@ -0,0 +1,38 @@
+/*
+ * upper_bound.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef UPPER_BOUND_H_
+#define UPPER_BOUND_H_
+
+#include "dice.h"
+
+#define DIRECAO_NENHUMA 4//ultima direcao de um dado que ainda nao rolou
+#define ESTADOS_LIMITE (24*5)//orientacao do dado x ultima direcao (ou nenhuma)
+
+/**Pontuacao maxima alcancavel em k rolagens, para cada orientacao do dado e ultima direcao
+ * (o passeio nunca volta para a celula anterior, entao a rolagem inversa a ultima eh descartada).
+ * Guardada como [k*ESTADOS_LIMITE + estado] para k <= jogadas_tabeladas; a partir dai a tabela eh
+ * periodica: cada periodo_limite jogadas somam exatamente ganho_periodo pontos.
+ */
+extern int* pontuacao_max_para_cada_numero_jogadas;
+extern int jogadas_tabeladas;
+extern int periodo_limite;
+extern int ganho_periodo;
+
+void config_pontuacao_max();
+
+static inline int pontuacao_max(int jogadas, dice d, int ultima_direcao){
+	int estado = d*5 + ultima_direcao;
+	if (jogadas > jogadas_tabeladas){
+		int periodos = (jogadas - jogadas_tabeladas + periodo_limite - 1) / periodo_limite;
+		return pontuacao_max_para_cada_numero_jogadas[(jogadas - periodos*periodo_limite)*ESTADOS_LIMITE + estado]
+				+ periodos*ganho_periodo;
+	}
+	return pontuacao_max_para_cada_numero_jogadas[jogadas*ESTADOS_LIMITE + estado];
+}
+
+#endif /* UPPER_BOUND_H_ */
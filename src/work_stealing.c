@@ -0,0 +1,85 @@
+/*
+ * work_stealing.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#include <limits.h>
+#include <string.h>
+#include "work_stealing.h"
+
+bool busca_paralela;
+atomic_int workers_ocupados;
+
+void preparar_roubo(contexto* c){
+	pthread_mutex_lock(&c->trava_roubo);
+	atomic_store(&c->base_roubo, 0);
+	atomic_store(&c->limite_proprio, 0);
+	atomic_store(&c->topo_roubo, -1);
+	pthread_mutex_unlock(&c->trava_roubo);
+}
+
+/*Refaz no ladrao o caminho copiado em solucao_parcial[0..tamanho-1] e poe o ramo no topo da pilha*/
+static void iniciar_ramo(contexto* c, int tamanho, int ramo){
+	reset_stack(c);
+	c->solucao_parcial[-1] = c->origin;
+	for (int k = 0; k < tamanho; k++){
+		int vtx = c->solucao_parcial[k];
+		c->stack[++c->head_stack] = vtx;
+		visitar(c, vtx);
+		c->vertex_restantes--;
+		atomic_store_explicit(&c->posicao_caminho[c->head_solucao_parcial], c->head_stack, memory_order_relaxed);
+		c->head_solucao_parcial++;
+		roll_dice(c, vtx, c->solucao_parcial[k-1]);
+	}
+	c->stack[++c->head_stack] = ramo;
+
+	//o caminho fica abaixo da base: a subarvore dele nao eh deste contexto, e nada ali pode ser roubado
+	pthread_mutex_lock(&c->trava_roubo);
+	atomic_store(&c->base_roubo, tamanho);
+	atomic_store(&c->limite_proprio, tamanho);
+	atomic_store(&c->topo_roubo, c->head_stack);
+	pthread_mutex_unlock(&c->trava_roubo);
+}
+
+bool roubar_ramo(contexto* ladrao, contexto* vitima){
+	if (atomic_load_explicit(&vitima->topo_roubo, memory_order_relaxed)
+			<= atomic_load_explicit(&vitima->base_roubo, memory_order_relaxed))
+		return false;
+	if (pthread_mutex_trylock(&vitima->trava_roubo) != 0)
+		return false;
+
+	//base provisoria no infinito: qualquer desempilhamento da vitima espera a trava, entao tudo abaixo do
+	//topo lido depois disso fica parado enquanto o ladrao procura o ramo e copia o caminho
+	int base = atomic_load(&vitima->base_roubo);
+	atomic_store(&vitima->base_roubo, INT_MAX);
+	int topo = atomic_load(&vitima->topo_roubo);
+
+	//as posicoes do caminho sao crescentes, e as que passam do caminho atual valem INT_MAX; as entradas
+	//roubadas so aparecem aqui depois que o dono baixou a base
+	int profundidade = 0;
+	int ramo = -1;
+	for (int p = base; p < topo && ramo < 0; p++){
+		while (atomic_load_explicit(&vitima->posicao_caminho[profundidade], memory_order_relaxed) < p)
+			profundidade++;
+		if (atomic_load_explicit(&vitima->posicao_caminho[profundidade], memory_order_relaxed) != p
+				&& vitima->stack[p] != RAMO_ROUBADO)
+			ramo = p;
+	}
+	if (ramo < 0){
+		atomic_store(&vitima->base_roubo, base);
+		pthread_mutex_unlock(&vitima->trava_roubo);
+		return false;
+	}
+	memcpy(ladrao->solucao_parcial, vitima->solucao_parcial, sizeof(int)*profundidade);
+	int vtx = vitima->stack[ramo];
+	vitima->stack[ramo] = RAMO_ROUBADO;
+	atomic_store(&vitima->base_roubo, ramo+1);
+	atomic_store(&vitima->limite_proprio, ramo+1);
+	atomic_fetch_add(&workers_ocupados, 1);
+	pthread_mutex_unlock(&vitima->trava_roubo);
+
+	iniciar_ramo(ladrao, profundidade, vtx);
+	return true;
+}
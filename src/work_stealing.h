@@ -0,0 +1,61 @@
+/*
+ * work_stealing.h
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ */
+
+#ifndef WORK_STEALING_H_
+#define WORK_STEALING_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hikerdice_grasp.h"
+
+#define RAMO_ROUBADO -1//entrada da pilha levada por um ladrao; o dono so a descarta
+
+/**Roubo de trabalho do modo exato com varias threads: uma unica arvore de busca dividida entre os workers.
+ * A pilha de cada contexto eh o seu deque: o dono empilha e desempilha no topo, e um worker ocioso leva a
+ * entrada aberta mais baixa (o ramo mais raso) junto com a copia do caminho ate o pai dela, e refaz os
+ * dados rolando o caminho a partir da origem. Abaixo de base_roubo so ha entradas roubadas e o caminho
+ * ate elas. O ladrao trava a vitima, publica a base e so entao le o topo; o dono publica o topo e so
+ * entao le a base (o protocolo THE do Cilk), entao o dono so pega a trava quando desempilha abaixo da
+ * base, e nunca no caminho comum. Nesse momento a base volta para o fundo da pilha. A poda usa a
+ * incumbente atomica compartilhada.
+ */
+extern bool busca_paralela;//modo exato com mais de uma thread em andamento
+extern atomic_int workers_ocupados;//workers explorando um ramo; 0 com todos ociosos encerra a busca
+
+/*Deixa o contexto sem nada para roubar, antes do primeiro ramo*/
+void preparar_roubo(contexto* c);
+
+/**Tenta levar o ramo aberto mais raso da vitima. Em caso de sucesso, o ladrao passa a contar como ocupado e
+ * a sua pilha fica com o caminho copiado (ja visitado, com os dados rolados) e o ramo no topo.
+ */
+bool roubar_ramo(contexto* ladrao, contexto* vitima);
+
+/*O topo da pilha mudou por empilhamento: as entradas novas ficam visiveis para os ladroes*/
+static inline void publicar_topo(contexto* c){
+	atomic_store_explicit(&c->topo_roubo, c->head_stack, memory_order_release);
+}
+
+/**O dono acabou de desempilhar: abaixo da base, espera algum roubo em andamento na sua pilha terminar.
+ * Abaixo do topo so restam o caminho e entradas roubadas (que os ladroes pulam), entao a base volta para o
+ * fundo e os proximos desempilhamentos nao pegam mais a trava.
+ */
+static inline void liberar_topo(contexto* c){
+	atomic_store(&c->topo_roubo, c->head_stack);
+	if (c->head_stack < atomic_load(&c->base_roubo)){
+		pthread_mutex_lock(&c->trava_roubo);
+		atomic_store(&c->base_roubo, 0);
+		pthread_mutex_unlock(&c->trava_roubo);
+	}
+}
+
+/*A subarvore da entrada 'posicao' foi toda explorada por este contexto (nenhum ramo dela foi roubado)*/
+static inline bool subarvore_propria(contexto* c, int posicao){
+	return !busca_paralela || posicao >= atomic_load_explicit(&c->limite_proprio, memory_order_relaxed);
+}
+
+#endif /* WORK_STEALING_H_ */
@@ -0,0 +1,105 @@
+/*
+ * bench_dice.c
+ *
+ * Micro-benchmark das rolagens do dado: compara as tabelas de transicao de dice.c
+ * com a implementacao antiga (struct com as faces + copy_values + aritmetica).
+ * Tambem confere que as duas produzem a mesma face de baixo em cada passo.
+ *
+ * Compilar: gcc -std=gnu11 -O2 -o bench_dice tools/bench_dice.c src/dice.c
+ * Uso:      bench_dice [quantidade de rolagens]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../src/dice.h"
+
+//=============== implementacao antiga, usada como referencia
+typedef struct d_antigo{
+	int bottom, front, right;
+} dice_antigo;
+
+static void copy_values(dice_antigo* d1, dice_antigo* d2){
+	(*d2).bottom = (*d1).bottom;
+	(*d2).front = (*d1).front;
+	(*d2).right = (*d1).right;
+}
+
+static int roll_antigo(dice_antigo* d, dice_antigo* pai, int direcao){
+	copy_values(pai, d);
+	int old;
+	switch (direcao){
+	case ROLL_LEFT:
+		old = 7 - (*d).right;
+		(*d).right = (*d).bottom;
+		(*d).bottom = old;
+		break;
+	case ROLL_UP:
+		old = 7 - (*d).bottom;
+		(*d).bottom = (*d).front;
+		(*d).front = old;
+		break;
+	case ROLL_RIGHT:
+		old = 7 - (*d).bottom;
+		(*d).bottom = (*d).right;
+		(*d).right = old;
+		break;
+	default:
+		old = 7 - (*d).front;
+		(*d).front = (*d).bottom;
+		(*d).bottom = old;
+	}
+	return (*d).bottom;
+}
+//=============== fim da implementacao antiga
+
+static double segundos(struct timespec inicio, struct timespec fim){
+	return (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+}
+
+int main(int argc, char *argv[]){
+	long qtd_rolagens = argc >= 2 ? atol(argv[1]) : 100000000L;
+	unsigned char* direcoes = malloc(qtd_rolagens);
+	srand(42);
+	for (long k = 0; k < qtd_rolagens; k++)
+		direcoes[k] = rand() % 4;
+
+	//conferencia: as duas implementacoes devem concordar em todas as faces
+	dice_antigo antigo = {2, 1, 3}, tmp;
+	dice novo = DICE_INICIAL;
+	for (long k = 0; k < qtd_rolagens && k < 1000000; k++){
+		int b1 = roll_antigo(&tmp, &antigo, direcoes[k]);
+		antigo = tmp;
+		int b2 = roll(&novo, novo, direcoes[k]);
+		if (b1 != b2 || dice_front[novo] != antigo.front || dice_right[novo] != antigo.right){
+			printf("Divergencia na rolagem %ld\n", k);
+			return EXIT_FAILURE;
+		}
+	}
+
+	struct timespec inicio, fim;
+	long long soma_antiga = 0, soma_nova = 0;
+
+	antigo = (dice_antigo){2, 1, 3};
+	clock_gettime(CLOCK_MONOTONIC, &inicio);
+	for (long k = 0; k < qtd_rolagens; k++){
+		soma_antiga += roll_antigo(&tmp, &antigo, direcoes[k]);
+		antigo = tmp;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &fim);
+	double t_antigo = segundos(inicio, fim);
+
+	novo = DICE_INICIAL;
+	clock_gettime(CLOCK_MONOTONIC, &inicio);
+	for (long k = 0; k < qtd_rolagens; k++){
+		soma_nova += roll(&novo, novo, direcoes[k]);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &fim);
+	double t_novo = segundos(inicio, fim);
+
+	printf("Rolagens: %ld (somas %lld / %lld)\n", qtd_rolagens, soma_antiga, soma_nova);
+	printf("struct + aritmetica: %.3f s (%.2f ns/rolagem)\n", t_antigo, t_antigo*1e9/qtd_rolagens);
+	printf("tabela de estados:   %.3f s (%.2f ns/rolagem)\n", t_novo, t_novo*1e9/qtd_rolagens);
+	free(direcoes);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+# benchmark.py
+#
+#  Created on: 17 de out de 2026
+#      Author: Arthur
+#
+# Roda o solver sobre os mapas de test_case/ com sementes e populacoes fixas, mede o tempo de parede,
+# le os contadores impressos por print_solution() e grava CSV ou JSON. Com --baseline, compara com uma
+# execucao salva e termina com codigo 1 se houver regressao de pontuacao ou de tempo.
+#
+# python3 tools/benchmark.py ./hikerdice_grasp --sementes 1,2,3 --populacoes 10,100 --csv resultado.csv
+# python3 tools/benchmark.py ./hikerdice_grasp --json novo.json --baseline antigo.json --limite-tempo 10
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import time
+
+# campo -> expressao sobre a saida do solver (decodificada como latin-1, como os fontes)
+CAMPOS = [
+    ('pontuacao', r'Valor da melhor pontuacao: (\d+)'),
+    ('branches', r'Numero de branches: (\d+)'),
+    ('tempo_cpu', r'Tempo de processamento: ([\d.]+)'),
+    ('solucoes', r'Quantidade de solucoes encontradas: (\d+)'),
+    ('bound_pontuacao_max', r'Qtd de retornos por melhor pontua\S* alcan\S*: (\d+)'),
+    ('bound_preto_visitado', r'Qtd de retornos por v\S*rtice preto null ou visitado: (\d+)'),
+    ('bound_grau_vizinho_1', r'Qtd de retornos por grau de algum vizinho == 1: (\d+)'),
+    ('bound_desconexo', r'Qtd de retornos por desconexao do grafo: (\d+)'),
+    ('bound_transposicao', r'Qtd de retornos por transposicao: (\d+)'),
+    ('buscas_conexao', r'\(buscas: (\d+)\)'),
+    ('movimentos_forcados', r'Qtd de movimentos forcados: (\d+)'),
+    ('melhorias_busca_local', r'Qtd de melhorias da busca local: (\d+)'),
+    ('ramos_roubados', r'Qtd de ramos roubados: (\d+)'),
+]
+
+COLUNAS = ['mapa', 'origem_i', 'origem_j', 'semente', 'populacao', 'threads', 'repeticao', 'status',
+           'tempo_parede', 'restarts_por_segundo'] + [nome for nome, _ in CAMPOS]
+
+
+def origem_do_mapa(caminho):
+    """Primeira celula livre em ordem de leitura (o mapa texto eh 'm,n' seguido das linhas)."""
+    with open(caminho) as fp:
+        valores = [int(v) for v in re.findall(r'\d+', fp.read())]
+    m, n = valores[0], valores[1]
+    for k, v in enumerate(valores[2:2 + m * n]):
+        if v != 0:
+            return k // n, k % n
+    return None
+
+
+def executar(binario, mapa, origem, semente, populacao, threads, timeout, extras):
+    comando = [binario, mapa, str(origem[0]), str(origem[1]), str(populacao),
+               '-t', str(threads), '-r', str(semente)] + extras
+    inicio = time.monotonic()
+    try:
+        proc = subprocess.run(comando, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return {'status': 'timeout', 'tempo_parede': timeout}
+    decorrido = time.monotonic() - inicio
+
+    saida = proc.stdout.decode('latin-1')
+    linha = {'status': 'ok' if proc.returncode == 0 else 'erro', 'tempo_parede': round(decorrido, 6)}
+    if 'Nao existe solucao' in saida:
+        linha['status'] = 'impar'
+    for nome, expressao in CAMPOS:
+        achado = re.search(expressao, saida)
+        if achado:
+            linha[nome] = float(achado.group(1)) if nome == 'tempo_cpu' else int(achado.group(1))
+    if linha['status'] == 'ok' and 'pontuacao' not in linha:
+        linha['status'] = 'erro'
+    if linha['status'] == 'ok':
+        linha['restarts_por_segundo'] = round(populacao / decorrido, 2) if decorrido > 0 else None
+    return linha
+
+
+def chave(linha):
+    return (linha['mapa'], int(linha['semente']), int(linha['populacao']), int(linha['threads']))
+
+
+def agrupar(linhas):
+    """Mediana do tempo de parede e melhor pontuacao por (mapa, semente, populacao, threads)."""
+    grupos = {}
+    for linha in linhas:
+        grupos.setdefault(chave(linha), []).append(linha)
+    resumo = {}
+    for k, grupo in grupos.items():
+        validas = [l for l in grupo if l['status'] == 'ok']
+        resumo[k] = {
+            'status': 'ok' if validas else grupo[0]['status'],
+            'tempo': statistics.median(float(l['tempo_parede']) for l in validas) if validas else None,
+            'pontuacao': max(int(l['pontuacao']) for l in validas) if validas else None,
+        }
+    return resumo
+
+
+def carregar(caminho):
+    if caminho.endswith('.json'):
+        with open(caminho) as fp:
+            return json.load(fp)
+    with open(caminho, newline='') as fp:
+        return list(csv.DictReader(fp))
+
+
+def comparar(linhas, caminho_baseline, limite_tempo, tempo_minimo):
+    atual = agrupar(linhas)
+    base = agrupar(carregar(caminho_baseline))
+    regressoes = 0
+    for k in sorted(atual):
+        if k not in base:
+            continue
+        a, b = atual[k], base[k]
+        descricao = '%s semente=%d pop=%d threads=%d' % k
+        if b['status'] == 'ok' and a['status'] != 'ok':
+            print('REGRESSAO %s: status %s (baseline ok)' % (descricao, a['status']))
+            regressoes += 1
+            continue
+        if a['status'] != 'ok' or b['status'] != 'ok':
+            continue
+        if a['pontuacao'] < b['pontuacao']:
+            print('REGRESSAO %s: pontuacao %d < %d' % (descricao, a['pontuacao'], b['pontuacao']))
+            regressoes += 1
+        variacao = (a['tempo'] - b['tempo']) / b['tempo'] * 100 if b['tempo'] > 0 else 0
+        if max(a['tempo'], b['tempo']) >= tempo_minimo and variacao > limite_tempo:
+            print('REGRESSAO %s: tempo %.3fs -> %.3fs (%+.1f%%)' % (descricao, b['tempo'], a['tempo'], variacao))
+            regressoes += 1
+        elif max(a['tempo'], b['tempo']) >= tempo_minimo and variacao < -limite_tempo:
+            print('melhora   %s: tempo %.3fs -> %.3fs (%+.1f%%)' % (descricao, b['tempo'], a['tempo'], variacao))
+    print('%d regressao(oes) contra %s' % (regressoes, caminho_baseline))
+    return regressoes
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark do hikerdice_grasp sobre test_case/')
+    parser.add_argument('binario', help='executavel do solver')
+    parser.add_argument('--mapas', default=os.path.join(os.path.dirname(__file__), '..', 'test_case', '*.txt'),
+                        help='glob dos mapas (padrao: test_case/*.txt)')
+    parser.add_argument('--sementes', default='1,2,3')
+    parser.add_argument('--populacoes', default='10,100')
+    parser.add_argument('--threads', default='1')
+    parser.add_argument('--repeticoes', type=int, default=1)
+    parser.add_argument('--timeout', type=float, default=30, help='segundos por execucao')
+    parser.add_argument('--csv', help='grava o resultado em CSV')
+    parser.add_argument('--json', help='grava o resultado em JSON')
+    parser.add_argument('--baseline', help='CSV ou JSON de uma execucao anterior para comparacao')
+    parser.add_argument('--limite-tempo', type=float, default=10, help='regressao de tempo tolerada, em %%')
+    parser.add_argument('--tempo-minimo', type=float, default=0.05,
+                        help='execucoes mais rapidas que isso nao entram na comparacao de tempo')
+    parser.add_argument('extras', nargs='*', help='argumentos repassados ao solver (depois de --)')
+    args = parser.parse_args()
+
+    sementes = [int(s) for s in args.sementes.split(',')]
+    populacoes = [int(p) for p in args.populacoes.split(',')]
+    threads = [int(t) for t in args.threads.split(',')]
+
+    linhas = []
+    for mapa in sorted(glob.glob(args.mapas)):
+        origem = origem_do_mapa(mapa)
+        if origem is None:
+            continue
+        for populacao in populacoes:
+            for semente in sementes:
+                for qtd_threads in threads:
+                    for repeticao in range(args.repeticoes):
+                        linha = {'mapa': os.path.basename(mapa), 'origem_i': origem[0], 'origem_j': origem[1],
+                                 'semente': semente, 'populacao': populacao, 'threads': qtd_threads,
+                                 'repeticao': repeticao}
+                        linha.update(executar(args.binario, mapa, origem, semente, populacao, qtd_threads,
+                                              args.timeout, args.extras))
+                        linhas.append(linha)
+                        print('%-22s pop=%-5d semente=%-4d threads=%-2d %-7s %8.3fs pontuacao=%s branches=%s' % (
+                            linha['mapa'], populacao, semente, qtd_threads, linha['status'], linha['tempo_parede'],
+                            linha.get('pontuacao', '-'), linha.get('branches', '-')), flush=True)
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as fp:
+            escritor = csv.DictWriter(fp, fieldnames=COLUNAS)
+            escritor.writeheader()
+            escritor.writerows(linhas)
+    if args.json:
+        with open(args.json, 'w') as fp:
+            json.dump(linhas, fp, indent=1)
+
+    if args.baseline and comparar(linhas, args.baseline, args.limite_tempo, args.tempo_minimo) > 0:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,33 @@
+/*
+ * mapa_binario.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ *
+ * Converte um mapa texto (m,n seguido das celulas) para o formato binario compacto lido pelo solver.
+ * gcc -std=gnu11 -O2 -o mapa_binario tools/mapa_binario.c src/map_loader.c src/graph.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/map_loader.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 3){
+		printf("Uso: mapa_binario <mapa texto> <mapa binario>\n");
+		return EXIT_FAILURE;
+	}
+	grid g = {0};
+	int livres = 0;
+	if (!carregar_mapa(argv[1], &g, &livres)){
+		printf("Impossivel ler o mapa %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	if (!salvar_mapa_binario(argv[2], &g)){
+		printf("Impossivel escrever o mapa %s\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+	printf("%s: %d x %d, %d celulas livres\n", argv[2], g.m, g.n, livres);
+	free(g.black);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+/*
+ * verificar_solucao.c
+ *
+ *  Created on: 17 de out de 2026
+ *      Author: Arthur
+ *
+ * Refaz um passeio salvo com -o/-b aplicando as regras do dado, e confere se ele eh um ciclo
+ * hamiltoniano das celulas livres a partir da origem e se a pontuacao declarada esta correta.
+ * gcc -std=gnu11 -O2 -o verificar_solucao tools/verificar_solucao.c src/solution_output.c src/map_loader.c src/graph.c src/dice.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/map_loader.h"
+#include "../src/solution_output.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 5){
+		printf("Uso: verificar_solucao <mapa> <linha origem> <coluna origem> <arquivo de movimentos>\n");
+		return EXIT_FAILURE;
+	}
+	grid g = {0};
+	int livres = 0;
+	if (!carregar_mapa(argv[1], &g, &livres)){
+		printf("Impossivel ler o mapa %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	int qtd = 0, pontuacao_declarada = 0;
+	uint8_t* movimentos = carregar_movimentos(argv[4], &qtd, &pontuacao_declarada);
+	if (movimentos == NULL){
+		printf("Impossivel ler os movimentos %s\n", argv[4]);
+		return EXIT_FAILURE;
+	}
+	int origem_i = atoi(argv[2]), origem_j = atoi(argv[3]);
+	if (origem_i < 0 || origem_i >= g.m || origem_j < 0 || origem_j >= g.n
+			|| g.black[grid_index(&g, origem_i, origem_j)]){
+		printf("INVALIDA: origem fora do mapa ou preta\n");
+		return EXIT_FAILURE;
+	}
+	int origem = grid_index(&g, origem_i, origem_j);
+	if (qtd != livres){
+		printf("INVALIDA: %d movimentos para %d celulas livres\n", qtd, livres);
+		return EXIT_FAILURE;
+	}
+
+	bool* visitado = (bool*) calloc(g.tamanho, sizeof(bool));
+	int atual = origem;
+	dice d = DICE_INICIAL;
+	int pontuacao = 0;
+	for (int k = 0; k < qtd; k++){
+		int proximo = atual + g.deslocamento[movimentos[k]];
+		if (g.black[proximo] || visitado[proximo]){
+			printf("INVALIDA: movimento %d (%c) leva a [%d,%d], preta ou ja visitada\n",
+					k, letra_movimento[movimentos[k]], grid_i(&g, proximo), grid_j(&g, proximo));
+			return EXIT_FAILURE;
+		}
+		visitado[proximo] = true;
+		pontuacao += roll(&d, d, movimentos[k]);
+		atual = proximo;
+	}
+	if (atual != origem){
+		printf("INVALIDA: o passeio nao termina na origem\n");
+		return EXIT_FAILURE;
+	}
+	if (pontuacao != pontuacao_declarada){
+		printf("INVALIDA: pontuacao %d, declarada %d\n", pontuacao, pontuacao_declarada);
+		return EXIT_FAILURE;
+	}
+	printf("OK: %d movimentos, pontuacao %d\n", qtd, pontuacao);
+	free(visitado);
+	free(movimentos);
+	free(g.black);
+	return EXIT_SUCCESS;
+}